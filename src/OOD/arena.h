@@ -0,0 +1,174 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+/*
+单调（bump-pointer）arena
+  从一串内存块里顺序切分：分配只是把指针往后挪并对齐，释放单个对象什么也不做，
+  reset() 一次性作废所有分配。适合"请求开始 -> 大量临时对象 -> 请求结束全部丢弃"的场景。
+
+  - 当前块不够时向上游申请新块，块大小几何增长。
+  - reset() 时如果已经有多个块，就合并成一个总容量相同的大块；
+    于是同样规模的请求再来，只用这一块就够了，稳态下零次上游分配。
+  - 继承 std::pmr::memory_resource，可以直接给 std::pmr 容器用；
+    ArenaAllocator<T> 是给 Vector<T, Alloc> 用的配置器。
+  - 上游默认是 new_delete_resource，也可以换成别的 memory_resource。
+  注意：不是线程安全的，每个请求/线程用自己的 arena。
+*/
+class Arena : public std::pmr::memory_resource {
+public:
+    explicit Arena(const size_t blockSize = 4096,
+                   std::pmr::memory_resource *upstream = std::pmr::new_delete_resource())
+        : nextBlock_(std::max<size_t>(blockSize, 256)), upstream_(upstream) {
+    }
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    ~Arena() override {
+        release();
+    }
+
+    // 作废所有分配；多个块合并成一个，之后同样规模的使用不再向上游要内存
+    void reset() {
+        if (head_ == nullptr)
+            return;
+        if (head_->prev != nullptr) {
+            const size_t total = capacity();
+            release();
+            add_block(total);
+        }
+        cur_ = head_->data();
+        end_ = cur_ + head_->size;
+        used_ = 0;
+    }
+
+    // 把所有块还给上游
+    void release() {
+        while (head_ != nullptr) {
+            Block *prev = head_->prev;
+            upstream_->deallocate(head_, sizeof(Block) + head_->size, alignof(std::max_align_t));
+            head_ = prev;
+        }
+        cur_ = end_ = nullptr;
+        used_ = 0;
+    }
+
+    // 统计
+    [[nodiscard]] size_t used() const { return used_; }
+    [[nodiscard]] size_t upstream_calls() const { return upstreamCalls_; }
+
+    [[nodiscard]] size_t capacity() const {
+        size_t total = 0;
+        for (const Block *b = head_; b != nullptr; b = b->prev)
+            total += b->size;
+        return total;
+    }
+
+    [[nodiscard]] size_t blocks() const {
+        size_t n = 0;
+        for (const Block *b = head_; b != nullptr; b = b->prev)
+            ++n;
+        return n;
+    }
+
+protected:
+    void *do_allocate(const size_t bytes, const size_t align) override {
+        char *p = align_up(cur_, align);
+        if (p == nullptr || p + bytes > end_) {
+            add_block(std::max(bytes + align, nextBlock_));
+            nextBlock_ *= 2;
+            p = align_up(cur_, align);
+        }
+        cur_ = p + bytes;
+        used_ += bytes;
+        return p;
+    }
+
+    // 单调：单个释放什么也不做，等 reset()
+    void do_deallocate(void *, size_t, size_t) override {
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    // 块头后面紧跟着数据区
+    struct alignas(std::max_align_t) Block {
+        Block *prev;
+        size_t size;
+
+        char *data() { return reinterpret_cast<char *>(this + 1); }
+    };
+
+    static char *align_up(char *p, const size_t align) {
+        const auto v = reinterpret_cast<uintptr_t>(p);
+        return reinterpret_cast<char *>((v + align - 1) & ~(align - 1));
+    }
+
+    void add_block(const size_t size) {
+        void *raw = upstream_->allocate(sizeof(Block) + size, alignof(std::max_align_t));
+        ++upstreamCalls_;
+        head_ = ::new(raw) Block{head_, size};
+        cur_ = head_->data();
+        end_ = cur_ + size;
+    }
+
+    Block *head_ = nullptr;
+    char *cur_ = nullptr;
+    char *end_ = nullptr;
+    size_t used_ = 0;
+    size_t nextBlock_;
+    size_t upstreamCalls_ = 0;
+    std::pmr::memory_resource *upstream_;
+};
+
+// ======================================================
+// 给 Vector<T, Alloc> 用的 arena 配置器
+// 接口与 templates_vector.h 的 Allocator<T> 相同，另外带有 value_type / rebind 构造，
+// 也能用在标准容器上
+// ======================================================
+template<typename T>
+struct ArenaAllocator {
+    using value_type = T;
+
+    explicit ArenaAllocator(Arena &a) : arena(&a) {
+    }
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) : arena(other.arena) {
+    }
+
+    T *allocate(const size_t n) {
+        return static_cast<T *>(arena->allocate(sizeof(T) * n, alignof(T)));
+    }
+
+    // 单调：归还什么也不做
+    void deallocate(T *) {
+    }
+
+    void deallocate(T *, size_t) {
+    }
+
+    template<typename... Args>
+    void construct(T *ptr, Args &&... args) {
+        new(ptr) T(std::forward<Args>(args)...);
+    }
+
+    void destroy(T *ptr) {
+        ptr->~T();
+    }
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U> &other) const {
+        return arena == other.arena;
+    }
+
+    Arena *arena;
+};
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#include "../multi_threads/epoch_reclaim.h"
+
+/*
+无锁 MPMC 队列（Michael-Scott）+ 带标签的无锁对象池
+  结构与 pooled_queue.h 的 Queue<T> 相同：哨兵节点链表，节点来自对象池。
+  区别在于：
+  1. head / tail / next 都是原子指针，入队用 CAS 挂到尾部再推进 tail，
+     出队用 CAS 推进 head；tail 落后时任何线程都可以帮忙推进。
+  2. 对象池是 Treiber 栈，栈顶是 (标签 << 32 | 节点下标)。
+     每次修改标签加一，所以"A 被弹出、又被压回"之后，旧的 CAS 一定失败（ABA）。
+     池中的内存只增不还，读到一个刚被别人弹走的节点的 nextFree 也不会越界。
+  3. 出队后的旧哨兵不能立刻还给池：别的线程可能还在读它的 next。
+     交给 EBR（multi_threads/epoch_reclaim.h），确认没人引用后才放回池里。
+*/
+
+// 无锁、ABA 安全的定长对象池；按块增长，块不归还
+template<typename T>
+class TaggedPool {
+public:
+    TaggedPool() = default;
+    TaggedPool(const TaggedPool &) = delete;
+    TaggedPool &operator=(const TaggedPool &) = delete;
+
+    ~TaggedPool() {
+        const uint32_t n = chunkCount_.load();
+        for (uint32_t c = 0; c < n && c < kMaxChunks; ++c)
+            delete[] chunks_[c].load();
+    }
+
+    // 返回一块能放下 T 的未初始化内存
+    void *allocate() {
+        uint64_t top = head_.load(std::memory_order_acquire);
+        while (index_of(top) != kNil) {
+            Slot *s = slot_at(index_of(top));
+            const uint32_t next = s->nextFree.load(std::memory_order_relaxed);
+            if (head_.compare_exchange_weak(top, pack(tag_of(top) + 1, next),
+                                            std::memory_order_acquire,
+                                            std::memory_order_acquire))
+                return s->raw;
+        }
+        return grow();
+    }
+
+    void deallocate(void *p) {
+        Slot *s = reinterpret_cast<Slot *>(p);
+        push_chain(s, s);
+    }
+
+    // 统计：已分配的块数
+    [[nodiscard]] uint32_t chunks() const { return chunkCount_.load(); }
+
+private:
+    static constexpr uint32_t kChunkShift = 12;
+    static constexpr uint32_t kChunkSize = 1u << kChunkShift; // 每块 4096 个节点
+    static constexpr uint32_t kMaxChunks = 1u << 14;          // 最多约 6700 万个节点
+    static constexpr uint32_t kNil = ~uint32_t{0};
+
+    // raw 放在第一个成员，节点指针可以直接转回 Slot*
+    struct Slot {
+        alignas(T) unsigned char raw[sizeof(T)];
+        uint32_t self = 0;
+        std::atomic<uint32_t> nextFree{kNil};
+    };
+
+    static uint64_t pack(uint64_t tag, uint32_t index) { return (tag << 32) | index; }
+    static uint32_t index_of(uint64_t v) { return static_cast<uint32_t>(v); }
+    static uint32_t tag_of(uint64_t v) { return static_cast<uint32_t>(v >> 32); }
+
+    Slot *slot_at(uint32_t index) const {
+        return &chunks_[index >> kChunkShift].load(std::memory_order_acquire)[index & (kChunkSize - 1)];
+    }
+
+    // 把 first..last 这一串（已经用 nextFree 连好）压回栈顶
+    void push_chain(Slot *first, Slot *last) {
+        uint64_t top = head_.load(std::memory_order_relaxed);
+        do {
+            last->nextFree.store(index_of(top), std::memory_order_relaxed);
+        } while (!head_.compare_exchange_weak(top, pack(tag_of(top) + 1, first->self),
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed));
+    }
+
+    // 池空：新开一块，第 0 个留给调用者，其余整串压入池中
+    void *grow() {
+        const uint32_t c = chunkCount_.fetch_add(1);
+        if (c >= kMaxChunks)
+            throw std::bad_alloc();
+        Slot *chunk = new Slot[kChunkSize];
+        for (uint32_t i = 0; i < kChunkSize; ++i) {
+            chunk[i].self = (c << kChunkShift) | i;
+            if (i + 1 < kChunkSize)
+                chunk[i].nextFree.store(chunk[i].self + 1, std::memory_order_relaxed);
+        }
+        chunks_[c].store(chunk, std::memory_order_release);
+        push_chain(&chunk[1], &chunk[kChunkSize - 1]);
+        return chunk[0].raw;
+    }
+
+    alignas(64) std::atomic<uint64_t> head_{pack(0, kNil)};
+    alignas(64) std::atomic<uint32_t> chunkCount_{0};
+    std::atomic<Slot *> chunks_[kMaxChunks] = {};
+};
+
+template<typename T>
+class ConcurrentQueue {
+public:
+    struct Node {
+        T data;
+        std::atomic<Node *> next{nullptr};
+
+        explicit Node(T d) : data(std::move(d)) {
+        }
+
+        // 所有 ConcurrentQueue<T> 共用一个池，和 Queue<T>::Node::freeList 一样按类型静态
+        static TaggedPool<Node> &pool() {
+            static TaggedPool<Node> p;
+            return p;
+        }
+
+        void *operator new(size_t) { return pool().allocate(); }
+
+        void operator delete(void *ptr) { pool().deallocate(ptr); }
+    };
+
+    // 构造：创建哨兵节点
+    ConcurrentQueue() : domain_(domain()) {
+        Node *dummy = new Node(T());
+        head_.store(dummy, std::memory_order_relaxed);
+        tail_.store(dummy, std::memory_order_relaxed);
+    }
+
+    ConcurrentQueue(const ConcurrentQueue &) = delete;
+    ConcurrentQueue &operator=(const ConcurrentQueue &) = delete;
+
+    // 析构：此时不应再有其他线程访问，直接删除剩余节点
+    ~ConcurrentQueue() {
+        Node *n = head_.load();
+        while (n != nullptr) {
+            Node *next = n->next.load(std::memory_order_relaxed);
+            delete n;
+            n = next;
+        }
+    }
+
+    // 入队：CAS 挂到尾节点的 next 上，再尝试推进 tail
+    void enqueue(T data) {
+        Node *node = new Node(std::move(data));
+        auto guard = domain_.pin();
+        while (true) {
+            Node *t = tail_.load(std::memory_order_acquire);
+            Node *next = t->next.load(std::memory_order_acquire);
+            if (t != tail_.load(std::memory_order_acquire))
+                continue;
+            if (next == nullptr) {
+                if (t->next.compare_exchange_weak(next, node, std::memory_order_release,
+                                                  std::memory_order_relaxed)) {
+                    tail_.compare_exchange_strong(t, node, std::memory_order_release,
+                                                  std::memory_order_relaxed);
+                    return;
+                }
+            } else {
+                // tail 落后了，帮忙推进
+                tail_.compare_exchange_strong(t, next, std::memory_order_release,
+                                              std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // 出队：成功返回 true；队空返回 false（并发下不抛异常，由调用者决定怎么等）
+    bool try_dequeue(T &out) {
+        auto guard = domain_.pin();
+        while (true) {
+            Node *h = head_.load(std::memory_order_acquire);
+            Node *t = tail_.load(std::memory_order_acquire);
+            Node *next = h->next.load(std::memory_order_acquire);
+            if (h != head_.load(std::memory_order_acquire))
+                continue;
+            if (next == nullptr)
+                return false;
+            if (h == t) {
+                tail_.compare_exchange_strong(t, next, std::memory_order_release,
+                                              std::memory_order_relaxed);
+                continue;
+            }
+            if (head_.compare_exchange_weak(h, next, std::memory_order_acq_rel,
+                                            std::memory_order_relaxed)) {
+                // next 成为新哨兵，只有赢得 CAS 的线程会碰它的 data
+                out = std::move(next->data);
+                domain_.retire(h, &destroy);
+                return true;
+            }
+        }
+    }
+
+    // 判空：并发下只是一个瞬时快照
+    [[nodiscard]] bool empty() const {
+        auto guard = domain_.pin();
+        return head_.load(std::memory_order_acquire)->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+private:
+    // 每个 ConcurrentQueue<T> 类型一个 EBR 域，先构造池、再构造域：静态析构时域先于池销毁，
+    // 域里剩余的节点还能还回池。不能用共享的 EpochDomain::global()：它只比第一个用到它的类型的池晚构造，
+    // 第二个类型的池会先于它析构，域析构时再把节点还给已经销毁的池
+    static reclaim::EpochDomain &domain() {
+        (void)Node::pool();
+        static reclaim::EpochDomain d;
+        return d;
+    }
+
+    static void destroy(void *p) { delete static_cast<Node *>(p); }
+
+    alignas(64) std::atomic<Node *> head_;
+    alignas(64) std::atomic<Node *> tail_;
+    reclaim::EpochDomain &domain_;
+};
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <sys/mman.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory_resource>
+#include <new>
+
+/*
+大页内存
+  池子几十 GB 时，4KB 页意味着海量页表项，随机访问的 TLB 缺失非常多；
+  换成 2MB 大页，同样的 TLB 能覆盖 512 倍的内存。
+
+  三种模式：
+    Off          普通 mmap（4KB 页）
+    Transparent  mmap 后按 2MB 对齐并 madvise(MADV_HUGEPAGE)，由内核透明大页（THP）尽量用大页
+    Explicit     MAP_HUGETLB，使用预留的 hugetlbfs 大页（需要 vm.nr_hugepages > 0）
+  Explicit 失败（没有预留大页）时退回 Transparent；THP 被关闭时 madvise 失败，退回普通页，
+  内存照样可用，只是没有大页。
+
+  HugePageResource 是 std::pmr::memory_resource，可以作为 Arena 的上游，
+  也可以通过 set_upstream 交给 NodePool / ObjectPool 申请块。
+  每次分配都是独立的 mmap，适合少量的大块（池和 arena 的块），不适合小对象。
+*/
+
+enum class HugePages { Off, Transparent, Explicit };
+
+inline const char *huge_pages_name(HugePages mode) {
+    switch (mode) {
+    case HugePages::Off:
+        return "off";
+    case HugePages::Transparent:
+        return "transparent";
+    case HugePages::Explicit:
+        return "explicit";
+    }
+    return "?";
+}
+
+// 当前进程里由 THP 提供的匿名大页总量（KB），读 /proc/self/smaps_rollup
+inline size_t anon_huge_kb() {
+    size_t kb = 0;
+    if (FILE *f = std::fopen("/proc/self/smaps_rollup", "r")) {
+        char line[256];
+        while (std::fgets(line, sizeof(line), f) != nullptr) {
+            if (std::strncmp(line, "AnonHugePages:", 14) == 0) {
+                kb = std::strtoull(line + 14, nullptr, 10);
+                break;
+            }
+        }
+        std::fclose(f);
+    }
+    return kb;
+}
+
+class HugePageResource : public std::pmr::memory_resource {
+public:
+    static constexpr size_t kHugePage = 2 * 1024 * 1024;
+    static constexpr size_t kPage = 4096;
+
+    explicit HugePageResource(const HugePages mode = HugePages::Transparent) : mode_(mode) {
+    }
+
+    [[nodiscard]] HugePages mode() const { return mode_; }
+
+    // 统计：映射的总字节数、MAP_HUGETLB 失败退回的次数、madvise 失败的次数
+    [[nodiscard]] size_t mapped() const { return mapped_.load(); }
+    [[nodiscard]] size_t hugetlb_fallbacks() const { return hugetlbFallbacks_.load(); }
+    [[nodiscard]] size_t advise_failures() const { return adviseFailures_.load(); }
+
+protected:
+    void *do_allocate(const size_t bytes, const size_t align) override {
+        if (align > kHugePage)
+            throw std::bad_alloc();
+        const size_t size = round_up(bytes);
+        void *p = nullptr;
+        if (mode_ == HugePages::Explicit) {
+            p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (p == MAP_FAILED) {
+                hugetlbFallbacks_.fetch_add(1, std::memory_order_relaxed);
+                p = nullptr;
+            }
+        }
+        if (p == nullptr)
+            p = mode_ == HugePages::Off ? map_plain(size) : map_transparent(size);
+        mapped_.fetch_add(size, std::memory_order_relaxed);
+        return p;
+    }
+
+    void do_deallocate(void *p, const size_t bytes, size_t) override {
+        const size_t size = round_up(bytes);
+        munmap(p, size);
+        mapped_.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    // 大页模式按 2MB 取整，普通模式按 4KB 取整；分配和释放用同一个规则
+    size_t round_up(const size_t bytes) const {
+        const size_t unit = mode_ == HugePages::Off ? kPage : kHugePage;
+        return (bytes + unit - 1) & ~(unit - 1);
+    }
+
+    static void *map_plain(const size_t size) {
+        void *p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+            throw std::bad_alloc();
+        return p;
+    }
+
+    // 多映射 2MB，裁掉首尾使起点按 2MB 对齐，THP 才能用整页覆盖
+    void *map_transparent(const size_t size) {
+        auto *raw = static_cast<char *>(map_plain(size + kHugePage));
+        const auto addr = reinterpret_cast<uintptr_t>(raw);
+        auto *aligned = reinterpret_cast<char *>((addr + kHugePage - 1) & ~(kHugePage - 1));
+        if (aligned > raw)
+            munmap(raw, aligned - raw);
+        const size_t tail = (raw + size + kHugePage) - (aligned + size);
+        if (tail > 0)
+            munmap(aligned + size, tail);
+        if (madvise(aligned, size, MADV_HUGEPAGE) != 0)
+            adviseFailures_.fetch_add(1, std::memory_order_relaxed);
+        return aligned;
+    }
+
+    HugePages mode_;
+    std::atomic<size_t> mapped_{0};
+    std::atomic<size_t> hugetlbFallbacks_{0};
+    std::atomic<size_t> adviseFailures_{0};
+};
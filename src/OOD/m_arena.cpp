@@ -0,0 +1,108 @@
+#include <chrono>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "arena.h"
+#include "../STL/templates_vector.h"
+
+/*
+Arena 演示：请求级临时数据
+  每个"请求"解析出一组 id（Vector<int>，逐个 push_back 触发多次扩容）
+  和一组较长的 token（std::pmr::vector<std::pmr::string>，超出 SSO，需要堆内存）。
+  比较：
+    malloc  Vector 用默认 Allocator（malloc），pmr 容器直接用 new_delete_resource
+    arena   两者都从同一个 Arena 分配，请求结束 reset()
+  统计每个请求向系统要内存的次数，以及总耗时。
+*/
+
+constexpr int kRequests = 20000;
+constexpr int kIds = 200;
+constexpr int kTokens = 32;
+
+// 统计上游分配次数的 memory_resource
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t calls = 0;
+
+protected:
+    void *do_allocate(size_t bytes, size_t align) override {
+        ++calls;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+
+    void do_deallocate(void *p, size_t bytes, size_t align) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+};
+
+// 统计 malloc 次数的 Allocator
+template<typename T>
+struct CountingAllocator : Allocator<T> {
+    static inline size_t calls = 0;
+
+    static T *allocate(const size_t n) {
+        ++calls;
+        return Allocator<T>::allocate(n);
+    }
+};
+
+// 一个请求：解析 id 和 token，返回一个校验值
+template<typename IdVector>
+long long handle_request(int r, IdVector &ids, std::pmr::memory_resource *mr) {
+    for (int i = 0; i < kIds; ++i)
+        ids.push_back(r + i);
+    std::pmr::vector<std::pmr::string> tokens(mr);
+    for (int i = 0; i < kTokens; ++i)
+        tokens.emplace_back("token-with-a-long-enough-name-" + std::to_string(i));
+    long long check = 0;
+    for (size_t i = 0; i < ids.size(); ++i)
+        check += ids[static_cast<int>(i)];
+    for (const auto &t : tokens)
+        check += static_cast<long long>(t.size());
+    return check;
+}
+
+int main() {
+    using Clock = std::chrono::steady_clock;
+
+    // malloc 版本
+    CountingResource heap;
+    long long a = 0;
+    auto start = Clock::now();
+    for (int r = 0; r < kRequests; ++r) {
+        Vector<int, CountingAllocator<int>> ids(4);
+        a += handle_request(r, ids, &heap);
+    }
+    const double mallocSec = std::chrono::duration<double>(Clock::now() - start).count();
+    const double mallocCalls = static_cast<double>(heap.calls + CountingAllocator<int>::calls) / kRequests;
+
+    // arena 版本
+    CountingResource upstream;
+    Arena arena(4096, &upstream);
+    long long b = 0;
+    size_t warmCalls = 0;
+    start = Clock::now();
+    for (int r = 0; r < kRequests; ++r) {
+        {
+            Vector<int, ArenaAllocator<int>> ids(4, ArenaAllocator<int>(arena));
+            b += handle_request(r, ids, &arena);
+        }
+        arena.reset();
+        if (r == 0)
+            warmCalls = upstream.calls;
+    }
+    const double arenaSec = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::cout << "每请求分配次数  malloc: " << mallocCalls << "  arena(首个请求): " << warmCalls
+              << "  arena(之后 " << kRequests - 1 << " 个请求合计): " << upstream.calls - warmCalls << std::endl;
+    std::cout << "arena 块数: " << arena.blocks() << "，容量 " << arena.capacity() << " 字节" << std::endl;
+    std::cout << "耗时  malloc: " << mallocSec << " s  arena: " << arenaSec << " s"
+              << (a == b ? "" : "  校验不一致!") << std::endl;
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "concurrent_queue.h"
+#include "pooled_queue.h"
+
+/*
+无锁 MPMC 队列 vs "Queue<T> + mutex"
+  N 个生产者各入队 kItems 个数，N 个消费者一起出队直到取完，
+  校验出队总和，并打印吞吐量。
+  mutex 版本把 Queue<T> 的每次操作都放进同一把锁里。
+*/
+
+constexpr int kItems = 200000;
+
+// Queue<T> 外面包一把锁
+template<typename T>
+class MutexQueue {
+public:
+    void enqueue(const T &v) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        q_.enqueue(v);
+    }
+
+    bool try_dequeue(T &out) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (q_.empty())
+            return false;
+        out = q_.front();
+        q_.dequeue();
+        return true;
+    }
+
+private:
+    std::mutex mtx_;
+    Queue<T> q_;
+};
+
+template<typename Q>
+double bench(int pairs, long long &checksum) {
+    Q q;
+    std::atomic<long long> total{0};
+    std::atomic<int> consumed{0};
+    const int expected = pairs * kItems;
+    std::vector<std::thread> ts;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int p = 0; p < pairs; ++p) {
+        ts.emplace_back([&q, p] {
+            for (int i = 0; i < kItems; ++i)
+                q.enqueue(p * kItems + i);
+        });
+        ts.emplace_back([&] {
+            long long local = 0;
+            int v = 0;
+            while (consumed.load(std::memory_order_relaxed) < expected) {
+                if (q.try_dequeue(v)) {
+                    local += v;
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            total.fetch_add(local);
+        });
+    }
+    for (auto &t : ts)
+        t.join();
+    checksum = total.load();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    // 基本用法
+    ConcurrentQueue<int> q;
+    q.enqueue(1);
+    q.enqueue(2);
+    q.enqueue(3);
+    int v = 0;
+    while (q.try_dequeue(v))
+        std::cout << v << " ";
+    std::cout << std::endl;
+
+    std::cout << "\n生产者/消费者对数\tmutex (Mops/s)\tlock-free (Mops/s)" << std::endl;
+    for (int pairs : {1, 2, 4, 8}) {
+        long long a = 0, b = 0;
+        const double mutexSec = bench<MutexQueue<int>>(pairs, a);
+        const double lockFreeSec = bench<ConcurrentQueue<int>>(pairs, b);
+        const double ops = 2.0 * pairs * kItems / 1e6;
+        std::cout << pairs << "\t\t\t" << ops / mutexSec << "\t\t" << ops / lockFreeSec
+                  << (a == b ? "" : "\t校验和不一致!") << std::endl;
+    }
+    std::cout << "节点池块数: " << ConcurrentQueue<int>::Node::pool().chunks() << std::endl;
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "pooled_queue.h"
+
+/*
+Queue<T>::Node 对象池：线程缓存 vs 全局自由链表 + 锁
+  一、每个线程反复分配/释放一批节点（256 个），比较：
+      locked  原来的单一静态自由链表，外面加一把 mutex（否则多线程就是数据竞争）
+      cached  线程缓存 + 全局仓库
+      new     直接用全局 operator new/delete
+  二、跨线程释放：生产者只分配、消费者只释放，检查节点会整批回到仓库供生产者复用，
+      而不是一直新开内存块。
+*/
+
+using Node = Queue<int>::Node;
+
+// 原来的设计：一个静态自由链表，加锁后才能多线程使用
+struct LockedFreeList {
+    struct Item {
+        int data;
+        Item *next;
+    };
+
+    static constexpr int POOL_ITEM_SIZE = 10000;
+    std::mutex mtx;
+    Item *freeList = nullptr;
+
+    Item *allocate() {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (freeList == nullptr) {
+            Item *block = new Item[POOL_ITEM_SIZE];
+            for (int i = 0; i < POOL_ITEM_SIZE - 1; ++i)
+                block[i].next = &block[i + 1];
+            block[POOL_ITEM_SIZE - 1].next = nullptr;
+            freeList = block;
+        }
+        Item *item = freeList;
+        freeList = item->next;
+        return item;
+    }
+
+    void deallocate(Item *item) {
+        std::lock_guard<std::mutex> lock(mtx);
+        item->next = freeList;
+        freeList = item;
+    }
+};
+
+struct Plain {
+    int data;
+    Plain *next;
+};
+
+constexpr int kBurst = 256;
+constexpr int kRounds = 2000;
+
+template<typename Alloc, typename Free>
+double run_threads(int threads, Alloc alloc, Free release) {
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> ts;
+    for (int t = 0; t < threads; ++t) {
+        ts.emplace_back([&] {
+            std::vector<void *> live(kBurst);
+            for (int r = 0; r < kRounds; ++r) {
+                for (auto &p : live)
+                    p = alloc();
+                for (auto *p : live)
+                    release(p);
+            }
+        });
+    }
+    for (auto &t : ts)
+        t.join();
+    const double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return 2.0 * threads * kBurst * kRounds / sec / 1e6;
+}
+
+int main() {
+    // 一、分配/释放吞吐
+    LockedFreeList locked;
+    std::cout << "线程数\tlocked (Mops/s)\tcached (Mops/s)\tnew (Mops/s)" << std::endl;
+    for (int threads : {1, 2, 4, 8}) {
+        const double a = run_threads(
+                threads, [&] { return static_cast<void *>(locked.allocate()); },
+                [&](void *p) { locked.deallocate(static_cast<LockedFreeList::Item *>(p)); });
+        const double b = run_threads(
+                threads, [] { return static_cast<void *>(new Node(0)); },
+                [](void *p) { delete static_cast<Node *>(p); });
+        const double c = run_threads(
+                threads, [] { return static_cast<void *>(new Plain{0, nullptr}); },
+                [](void *p) { delete static_cast<Plain *>(p); });
+        std::cout << threads << "\t" << a << "\t\t" << b << "\t\t" << c << std::endl;
+    }
+
+    // 二、跨线程释放
+    std::mutex mtx;
+    std::vector<std::vector<Node *>> handoff;
+    bool done = false;
+    std::thread producer([&] {
+        for (int r = 0; r < kRounds; ++r) {
+            std::vector<Node *> nodes(kBurst);
+            for (auto &n : nodes)
+                n = new Node(r);
+            std::lock_guard<std::mutex> lock(mtx);
+            handoff.push_back(std::move(nodes));
+        }
+        std::lock_guard<std::mutex> lock(mtx);
+        done = true;
+    });
+    std::thread consumer([&] {
+        while (true) {
+            std::vector<std::vector<Node *>> got;
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                got.swap(handoff);
+                if (got.empty() && done)
+                    break;
+            }
+            for (auto &nodes : got)
+                for (Node *n : nodes)
+                    delete n; // 在消费者线程释放生产者分配的节点
+            std::this_thread::yield();
+        }
+    });
+    producer.join();
+    consumer.join();
+    const PoolStats st = Node::pool().stats();
+    std::cout << "\n跨线程释放 " << kRounds * kBurst << " 个节点后: 容量 " << st.capacity << "，仓库空闲 "
+              << st.depot << "，线程缓存 " << st.cached << "，使用中 " << st.live << std::endl;
+    return 0;
+}
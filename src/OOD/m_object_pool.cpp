@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "object_pool.h"
+
+/*
+ObjectPool<T> 演示与基准
+  一、RAII 句柄、预热、对齐检查（Connection 是 alignas(64) 的过对齐类型）
+  二、分配/释放吞吐：每轮分配 kBatch 个对象，再按随机顺序释放，比较
+      new/delete、std::pmr::unsynchronized_pool_resource、ObjectPool
+*/
+
+struct alignas(64) Connection {
+    int fd;
+    uint64_t bytesIn = 0;
+    uint64_t bytesOut = 0;
+    std::string peer;
+
+    Connection(int f, std::string p) : fd(f), peer(std::move(p)) {
+    }
+};
+
+constexpr int kBatch = 1000;
+constexpr int kRounds = 2000;
+
+template<typename Alloc, typename Free>
+double bench(Alloc alloc, Free release) {
+    std::vector<Connection *> live(kBatch);
+    std::vector<int> order(kBatch);
+    for (int i = 0; i < kBatch; ++i)
+        order[i] = i;
+    std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < kRounds; ++r) {
+        for (int i = 0; i < kBatch; ++i)
+            live[i] = alloc(i);
+        for (int i : order)
+            release(live[i]);
+    }
+    const double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return 2.0 * kBatch * kRounds / sec / 1e6;
+}
+
+int main() {
+    // 一、基本用法
+    ObjectPool<Connection> pool;
+    pool.reserve(16); // 预热
+    {
+        auto a = pool.acquire(3, "10.0.0.1");
+        auto b = pool.acquire(4, "10.0.0.2");
+        std::cout << "fd=" << a->fd << " peer=" << a->peer << ", fd=" << b->fd << " peer=" << b->peer
+                  << std::endl;
+        std::cout << "对齐: " << std::boolalpha
+                  << (reinterpret_cast<uintptr_t>(a.get()) % alignof(Connection) == 0 &&
+                      reinterpret_cast<uintptr_t>(b.get()) % alignof(Connection) == 0)
+                  << "，使用中 " << pool.in_use() << "/" << pool.capacity() << std::endl;
+    } // 句柄析构，对象归还
+    std::cout << "句柄析构后使用中: " << pool.in_use() << std::endl;
+
+    // 二、吞吐
+    const double a = bench([](int i) { return new Connection(i, "peer"); },
+                           [](Connection *c) { delete c; });
+
+    std::pmr::unsynchronized_pool_resource resource;
+    std::pmr::polymorphic_allocator<Connection> pmrAlloc(&resource);
+    const double b = bench([&](int i) { return pmrAlloc.new_object<Connection>(i, "peer"); },
+                           [&](Connection *c) { pmrAlloc.delete_object(c); });
+
+    ObjectPool<Connection> benchPool;
+    benchPool.reserve(kBatch);
+    const double c = bench([&](int i) { return benchPool.create(i, "peer"); },
+                           [&](Connection *conn) { benchPool.destroy(conn); });
+
+    std::cout << "\n分配+释放 (Mops/s)" << std::endl;
+    std::cout << "  new/delete:                     " << a << std::endl;
+    std::cout << "  pmr::unsynchronized_pool:       " << b << std::endl;
+    std::cout << "  ObjectPool:                     " << c << std::endl;
+    return 0;
+}
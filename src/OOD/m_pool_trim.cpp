@@ -0,0 +1,64 @@
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "pooled_queue.h"
+
+/*
+对象池的内存回收：流量尖峰之后把内存还给系统
+  一、增长策略：小队列只占用一个小块，而不是一上来就提交 10000 个节点
+  二、尖峰：4 个线程各自把队列灌到 100000 个元素再清空，观察容量；手动 trim() 后再观察
+  三、水位线：设置后，仓库空闲节点超过水位线时自动 trim
+*/
+
+using Node = Queue<long>::Node;
+
+void print(const char *title) {
+    const PoolStats s = Node::pool().stats();
+    std::cout << title << "\t块 " << s.chunks << "\t容量 " << s.capacity << "\t使用中 " << s.live
+              << "\t线程缓存 " << s.cached << "\t仓库 " << s.depot << "\t" << s.bytes / 1024 << " KB"
+              << std::endl;
+}
+
+void spike(int threads, int items) {
+    std::vector<std::thread> ts;
+    for (int t = 0; t < threads; ++t) {
+        ts.emplace_back([items] {
+            Queue<long> q;
+            for (long i = 0; i < items; ++i)
+                q.enqueue(i);
+            while (!q.empty())
+                q.dequeue();
+        });
+    }
+    for (auto &t : ts)
+        t.join();
+}
+
+int main() {
+    // 一、增长策略
+    {
+        Queue<long> q;
+        for (long i = 0; i < 10; ++i)
+            q.enqueue(i);
+        print("小队列");
+    }
+
+    // 二、尖峰 + 手动 trim
+    spike(4, 100000);
+    print("尖峰后");
+    std::cout << "trim() 释放节点数: " << Node::pool().trim() << std::endl;
+    print("trim 后");
+
+    // 三、水位线自动 trim
+    Node::pool().set_trim_watermark(20000);
+    spike(4, 100000);
+    print("水位线 2 万");
+
+    // 稳态：回收后再次使用，池会按增长策略重新扩容
+    Node::pool().set_growth({256, 4096, 2.0});
+    spike(1, 50000);
+    print("再次增长");
+    return 0;
+}
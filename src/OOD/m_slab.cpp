@@ -0,0 +1,123 @@
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "slab_allocator.h"
+#include "../STL/templates_vector.h"
+
+/*
+slab 分配器 vs glibc malloc
+  三种负载都写成以配置器为模板参数，分别用 std::allocator（glibc）和 slab::StdAllocator 跑：
+  一、会话表：std::map<int, string>，插入 20 万个会话、随机删一半、再插回来（网络服务器里的连接表）
+  二、Vector 增长：templates_vector.h 的 Vector 逐个 push_back 字符串（元素字符串走配置器）
+  三、多线程小对象抖动：4 个线程随机大小（16~512 字节）分配/释放
+  打印耗时与负载峰值时的 RSS 增量。
+*/
+
+using Clock = std::chrono::steady_clock;
+
+// 当前 RSS（KB）
+long rss_kb() {
+    long pages = 0, resident = 0;
+    if (FILE *f = std::fopen("/proc/self/statm", "r")) {
+        if (std::fscanf(f, "%ld %ld", &pages, &resident) != 2)
+            resident = 0;
+        std::fclose(f);
+    }
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+template<template<typename> class A>
+using String = std::basic_string<char, std::char_traits<char>, A<char>>;
+
+template<template<typename> class A>
+double sessions(long &rssDelta) {
+    using Map = std::map<int, String<A>, std::less<>, A<std::pair<const int, String<A>>>>;
+    const long before = rss_kb();
+    const auto start = Clock::now();
+    Map table;
+    std::mt19937 rng(7);
+    constexpr int kSessions = 200000;
+    for (int i = 0; i < kSessions; ++i)
+        table.emplace(i, String<A>("peer-192.168.0." + std::to_string(i % 255) + ":session-token"));
+    for (int i = 0; i < kSessions / 2; ++i)
+        table.erase(static_cast<int>(rng() % kSessions));
+    for (int i = 0; i < kSessions; ++i)
+        table.emplace(i, String<A>("reconnected-peer-" + std::to_string(i) + "-with-longer-name"));
+    rssDelta = rss_kb() - before;
+    table.clear();
+    return seconds_since(start);
+}
+
+template<template<typename> class A>
+double vector_growth() {
+    const auto start = Clock::now();
+    for (int round = 0; round < 10; ++round) {
+        Vector<String<A>> v;
+        for (int i = 0; i < 20000; ++i)
+            v.push_back(String<A>("element-number-" + std::to_string(i) + "-padding"));
+    }
+    return seconds_since(start);
+}
+
+struct GlibcRaw {
+    static void *allocate(size_t n) { return std::malloc(n); }
+    static void deallocate(void *p) { std::free(p); }
+};
+
+struct SlabRaw {
+    static void *allocate(size_t n) { return slab::allocate(n); }
+    static void deallocate(void *p) { slab::deallocate(p); }
+};
+
+template<typename Raw>
+double churn(int threads) {
+    const auto start = Clock::now();
+    std::vector<std::thread> ts;
+    for (int t = 0; t < threads; ++t) {
+        ts.emplace_back([t] {
+            std::mt19937 rng(t);
+            std::vector<void *> live(1024, nullptr);
+            for (int i = 0; i < 1000000; ++i) {
+                void *&slot = live[rng() % live.size()];
+                Raw::deallocate(slot);
+                slot = Raw::allocate(16 + rng() % 497);
+            }
+            for (void *p : live)
+                Raw::deallocate(p);
+        });
+    }
+    for (auto &t : ts)
+        t.join();
+    return seconds_since(start);
+}
+
+int main() {
+    long glibcRss = 0, slabRss = 0;
+    const double a = sessions<std::allocator>(glibcRss);
+    const double b = sessions<slab::StdAllocator>(slabRss);
+    std::cout << "会话表        glibc: " << a << " s (RSS +" << glibcRss << " KB)   slab: " << b << " s (RSS +"
+              << slabRss << " KB)" << std::endl;
+
+    const double c = vector_growth<std::allocator>();
+    const double d = vector_growth<slab::StdAllocator>();
+    std::cout << "Vector 增长   glibc: " << c << " s   slab: " << d << " s" << std::endl;
+
+    const double e = churn<GlibcRaw>(4);
+    const double f = churn<SlabRaw>(4);
+    std::cout << "4 线程抖动    glibc: " << e << " s   slab: " << f << " s" << std::endl;
+
+    std::cout << "slab 已切出 span: " << slab::span_count() << " 个，" << slab::span_bytes() / 1024 << " KB"
+              << std::endl;
+    return 0;
+}
@@ -0,0 +1,56 @@
+#define SLAB_REPLACE_GLOBAL_NEW
+#include "slab_allocator.h"
+
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+用 slab 分配器替换整个程序的全局 operator new/delete
+  只需在一个 .cpp 里 #define SLAB_REPLACE_GLOBAL_NEW 后包含 slab_allocator.h，
+  之后所有 new / 标准容器 / 智能指针的分配都走 slab。
+  这里用几种常见用法验证：指针来自 slab 的保留区间、跨线程释放、线程退出后缓存被回收。
+*/
+
+struct alignas(64) CacheLine {
+    char bytes[64];
+};
+
+int main() {
+    auto *p = new int(42);
+    std::cout << "new int 来自 slab: " << std::boolalpha << slab::owns(p) << std::endl;
+    delete p;
+
+    auto big = std::make_unique<char[]>(64 * 1024);
+    std::cout << "64KB 数组来自 malloc: " << !slab::owns(big.get()) << std::endl;
+
+    auto *line = new CacheLine;
+    std::cout << "alignas(64) 对齐正确: " << (reinterpret_cast<uintptr_t>(line) % 64 == 0) << std::endl;
+    delete line;
+
+    // 在工作线程分配、主线程释放
+    std::vector<std::string *> handoff;
+    std::thread producer([&] {
+        for (int i = 0; i < 10000; ++i)
+            handoff.push_back(new std::string("message #" + std::to_string(i) + " from the producer thread"));
+    });
+    producer.join();
+    size_t bytes = 0;
+    for (std::string *s : handoff) {
+        bytes += s->size();
+        delete s;
+    }
+    std::cout << "跨线程释放 " << handoff.size() << " 个字符串，共 " << bytes << " 字节" << std::endl;
+
+    std::map<int, std::string> table;
+    for (int i = 0; i < 100000; ++i)
+        table.emplace(i, "value-" + std::to_string(i) + "-with-some-padding");
+    table.clear();
+
+    std::cout << "slab 已切出 span: " << slab::span_count() << " 个，" << slab::span_bytes() / 1024 << " KB"
+              << std::endl;
+    return 0;
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+/*
+通用对象池 ObjectPool<T>
+  独立的单线程自由链表池，按实例持有（不是静态的），可以用于连接、缓冲区、任务等任意类型。
+  它没有取代 pooled_queue.h 的 NodePool，Queue<T>::Node 仍然用 NodePool，两者解决的问题不同：
+    NodePool   每种节点类型一个静态池，线程缓存 + 加锁的全局仓库，节点可以在 A 线程分配、B 线程释放，
+               支持批量搬运和 trim；代价是每次 new/delete 都要访问 thread_local 缓存；
+    ObjectPool 一个实例只给一个线程用，acquire / 归还就是一次链表头操作，没有 thread_local 和锁；
+               另外提供 RAII 句柄、任意构造参数和 reserve 预热。
+  Queue 的节点会跨线程流动（m_node_cache.cpp），所以保留 NodePool；单线程拥有的容器
+  （intrusive_list.h 的 PooledList、segmented_deque.h）用 ObjectPool。
+  - acquire(args...) 在池中原地构造对象，返回 RAII 句柄，句柄析构时析构对象并把槽位还回池；
+    也可以用 create / destroy 手动管理。
+  - reserve(n) 预热：提前申请好 n 个槽位，之后的 acquire 不会再向系统要内存。
+  - 槽位是 union { next; T 的存储 }，块用带对齐参数的 operator new 申请，
+    保证 alignof(T) 的对齐（原来 reinterpret_cast 一个 char[] 并不保证，
+    过对齐的类型如 alignas(64) 会出错）。
+  - 块按几何增长（每次翻倍，封顶 maxChunk），池析构时统一释放。
+  - 可选的 upstream：块改从该 memory_resource 申请（例如 huge_pages.h 的 HugePageResource，
+    大池随机访问时用 2MB 大页减少 TLB 缺失）；默认 nullptr 用 operator new。
+  注意：不是线程安全的（与 std::pmr::unsynchronized_pool_resource 相同），每个线程用自己的池；
+  句柄不能比池活得更久。
+*/
+template<typename T>
+class ObjectPool {
+public:
+    // 句柄的删除器：析构对象并归还槽位
+    struct Deleter {
+        ObjectPool *pool;
+
+        void operator()(T *p) const {
+            pool->destroy(p);
+        }
+    };
+
+    using Handle = std::unique_ptr<T, Deleter>;
+
+    explicit ObjectPool(const size_t initialChunk = 64, const size_t maxChunk = 4096,
+                        std::pmr::memory_resource *upstream = nullptr)
+        : nextChunk(std::max<size_t>(1, initialChunk)), maxChunk(std::max(maxChunk, nextChunk)),
+          upstream(upstream) {
+    }
+
+    ObjectPool(const ObjectPool &) = delete;
+    ObjectPool &operator=(const ObjectPool &) = delete;
+
+    // 析构：释放所有块；此时所有对象都应该已经归还
+    ~ObjectPool() {
+        for (const Chunk &chunk : chunks) {
+            if (upstream != nullptr)
+                upstream->deallocate(chunk.begin, chunk.count * sizeof(Slot), alignof(Slot));
+            else
+                ::operator delete(chunk.begin, std::align_val_t{alignof(Slot)});
+        }
+    }
+
+    // 从池中取一个槽位并构造对象，返回 RAII 句柄
+    template<typename... Args>
+    Handle acquire(Args &&... args) {
+        return Handle(create(std::forward<Args>(args)...), Deleter{this});
+    }
+
+    // 手动版本：create 与 destroy 必须成对调用
+    template<typename... Args>
+    T *create(Args &&... args) {
+        Slot *slot = pop();
+        try {
+            return ::new(static_cast<void *>(slot->storage)) T(std::forward<Args>(args)...);
+        } catch (...) {
+            push(slot);
+            throw;
+        }
+    }
+
+    void destroy(T *p) {
+        if (p == nullptr) return;
+        p->~T();
+        push(reinterpret_cast<Slot *>(p));
+    }
+
+    // 预热：保证至少有 n 个空闲槽位
+    void reserve(const size_t n) {
+        while (freeCount < n)
+            grow(n - freeCount);
+    }
+
+    // 统计
+    [[nodiscard]] size_t capacity() const { return total; }
+    [[nodiscard]] size_t available() const { return freeCount; }
+    [[nodiscard]] size_t in_use() const { return total - freeCount; }
+    [[nodiscard]] size_t chunk_count() const { return chunks.size(); }
+
+private:
+    // 空闲时存 next，使用时存对象；storage 是第一个成员，T* 可以直接转回 Slot*
+    union Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+        Slot *next;
+    };
+
+    struct Chunk {
+        Slot *begin;
+        size_t count;
+    };
+
+    Slot *pop() {
+        if (freeList == nullptr)
+            grow(nextChunk);
+        Slot *slot = freeList;
+        freeList = slot->next;
+        --freeCount;
+        return slot;
+    }
+
+    void push(Slot *slot) {
+        slot->next = freeList;
+        freeList = slot;
+        ++freeCount;
+    }
+
+    // 申请一块至少 n 个槽位的内存并串进自由链表
+    void grow(const size_t n) {
+        const size_t count = std::max(n, nextChunk);
+        auto *chunk = static_cast<Slot *>(upstream != nullptr
+                                              ? upstream->allocate(count * sizeof(Slot), alignof(Slot))
+                                              : ::operator new(count * sizeof(Slot), std::align_val_t{alignof(Slot)}));
+        chunks.push_back(Chunk{chunk, count});
+        for (size_t i = count; i-- > 0;)
+            push(&chunk[i]); // 倒序压入，使取出顺序与地址顺序一致
+        total += count;
+        nextChunk = std::min(nextChunk * 2, maxChunk);
+    }
+
+    Slot *freeList = nullptr;
+    size_t freeCount = 0;
+    size_t total = 0;
+    size_t nextChunk;
+    size_t maxChunk;
+    std::pmr::memory_resource *upstream;
+    std::vector<Chunk> chunks;
+};
@@ -0,0 +1,397 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/*
+带对象池的单线程队列
+  哨兵节点链表：head 指向哨兵，tail 指向最后一个真实节点。
+  Node 重载 operator new/delete，从对象池取/还节点，避免每次入队都 malloc。
+
+对象池（仿 tcmalloc）
+  每个线程一个本地空闲链表，new/delete 只操作它，不需要任何同步；
+  本地链表空了从全局仓库拿一整批，多了就整批还回去，锁只在批量搬运时才用到。
+  节点在 A 线程分配、B 线程释放也没问题：它会进入 B 的缓存，之后再被 B 复用或还给仓库。
+  注意：对象池是线程安全的，但队列本身没有同步，同一个队列只能由一个线程（或在外部加锁）使用。
+
+内存回收
+  池记录向系统申请的每一块内存（chunk）。新块大小按增长策略几何增长并封顶，
+  第一次分配不再一口气提交 10000 个节点。
+  trim() 找出所有节点都在全局仓库里的块（即整块空闲），把它们还给系统；
+  设置水位线后，仓库空闲节点超过水位线时自动 trim；如果一次 trim 什么都没回收
+  （每一块里都还有节点在用），要再积累水位线 1/8 的空闲节点才会再扫描。
+  仍留在某个线程缓存里的节点会让所在的块无法回收，所以 trim() 会先清空调用线程的缓存。
+*/
+
+// 新块的节点数 = clamp(当前容量 * (factor - 1), initial, max)：默认每次让总容量翻倍
+struct GrowthPolicy {
+    size_t initial = 64;
+    size_t max = 10000;
+    double factor = 2.0;
+};
+
+struct PoolStats {
+    size_t chunks = 0;   // 向系统申请的块数
+    size_t capacity = 0; // 所有块的节点总数
+    size_t live = 0;     // 正在使用的节点
+    size_t cached = 0;   // 各线程缓存里的空闲节点
+    size_t depot = 0;    // 全局仓库里的空闲节点
+    size_t bytes = 0;    // 所有块占用的字节数
+};
+
+// 线程缓存 + 全局仓库的定长节点池；Node 需要有一个 Node *next 成员，空闲时用来串链表
+template<typename Node>
+class NodePool {
+public:
+    static constexpr size_t BATCH_SIZE = 64; // 线程缓存与全局仓库之间一次搬运的节点数
+    static constexpr size_t NO_WATERMARK = std::numeric_limits<size_t>::max();
+
+    NodePool() = default;
+    NodePool(const NodePool &) = delete;
+    NodePool &operator=(const NodePool &) = delete;
+
+    // 析构：进程退出时统一归还所有块
+    ~NodePool() {
+        for (const Chunk &c : chunks_)
+            free_chunk(c);
+    }
+
+    // 常见路径：只操作当前线程的缓存，缓存空了再从仓库整批补充
+    void *allocate() {
+        Cache &c = cache();
+        if (c.head == nullptr) {
+            const Batch b = refill();
+            c.head = b.head;
+            c.set_count(b.count);
+        }
+        Node *node = c.head;
+        c.head = node->next;
+        c.set_count(c.count.load(std::memory_order_relaxed) - 1);
+        return node;
+    }
+
+    // 归还到当前线程的缓存（不管节点是哪个线程分配的），
+    // 缓存超过两批时整批还给仓库，防止"一个线程只分配、另一个线程只释放"时节点全堆在释放方
+    void deallocate(void *ptr) {
+        Cache &c = cache();
+        Node *node = static_cast<Node *>(ptr);
+        node->next = c.head;
+        c.head = node;
+        const size_t n = c.count.load(std::memory_order_relaxed) + 1;
+        c.set_count(n);
+        if (n > 2 * BATCH_SIZE)
+            push_batch(c.take(BATCH_SIZE));
+    }
+
+    void set_growth(const GrowthPolicy &policy) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        policy_ = policy;
+    }
+
+    // 之后新申请的块从 upstream 分配（例如 huge_pages.h 的 HugePageResource）；nullptr 恢复 operator new
+    void set_upstream(std::pmr::memory_resource *upstream) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        upstream_ = upstream;
+    }
+
+    // 仓库空闲节点超过 nodes 时自动 trim；NO_WATERMARK 表示只在手动调用时 trim
+    void set_trim_watermark(const size_t nodes) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        watermark_ = nodes;
+        trimAt_ = watermark_;
+    }
+
+    // 把整块空闲的内存还给系统，返回释放的节点数
+    size_t trim() {
+        Cache &c = cache();
+        while (c.head != nullptr)
+            push_batch(c.take(std::min(c.count.load(std::memory_order_relaxed), BATCH_SIZE)));
+        std::lock_guard<std::mutex> lock(mtx_);
+        return trim_locked();
+    }
+
+    [[nodiscard]] PoolStats stats() {
+        std::lock_guard<std::mutex> lock(mtx_);
+        PoolStats s;
+        s.chunks = chunks_.size();
+        s.capacity = capacity_;
+        s.depot = depotNodes_;
+        for (const Cache *c : caches_)
+            s.cached += c->count.load(std::memory_order_relaxed);
+        s.live = capacity_ - s.depot - s.cached;
+        s.bytes = capacity_ * sizeof(Node);
+        return s;
+    }
+
+private:
+    // 一串用 next 连起来的空闲节点
+    struct Batch {
+        Node *head = nullptr;
+        size_t count = 0;
+    };
+
+    struct Chunk {
+        Node *begin;
+        size_t count;
+        std::pmr::memory_resource *upstream; // nullptr 表示 operator new
+    };
+
+    // 线程缓存：常见的 new/delete 只改这里，不碰任何共享状态。
+    // count 只有本线程写，用原子变量只是为了让 stats() 能读到
+    struct Cache {
+        explicit Cache(NodePool &p) : pool(p) {
+            std::lock_guard<std::mutex> lock(pool.mtx_);
+            pool.caches_.push_back(this);
+        }
+
+        // 线程退出时把剩余节点整批还给仓库，别的线程还能用
+        ~Cache() {
+            while (head != nullptr)
+                pool.push_batch(take(std::min(count.load(std::memory_order_relaxed), BATCH_SIZE)));
+            std::lock_guard<std::mutex> lock(pool.mtx_);
+            pool.caches_.erase(std::find(pool.caches_.begin(), pool.caches_.end(), this));
+        }
+
+        void set_count(const size_t n) {
+            count.store(n, std::memory_order_relaxed);
+        }
+
+        // 从缓存头部摘下 n 个节点
+        Batch take(const size_t n) {
+            Batch b{head, n};
+            Node *last = head;
+            for (size_t i = 1; i < n; ++i)
+                last = last->next;
+            head = last->next;
+            last->next = nullptr;
+            set_count(count.load(std::memory_order_relaxed) - n);
+            return b;
+        }
+
+        NodePool &pool;
+        Node *head = nullptr;
+        std::atomic<size_t> count{0};
+    };
+
+    Cache &cache() {
+        thread_local Cache c(*this);
+        return c;
+    }
+
+    void push_batch(const Batch b) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        batches_.push_back(b);
+        depotNodes_ += b.count;
+        if (depotNodes_ > trimAt_)
+            trim_locked();
+    }
+
+    // 仓库有整批就直接拿；仓库也空了就按增长策略申请新块，切成若干批，第一批直接给调用者
+    Batch refill() {
+        size_t n = 0;
+        std::pmr::memory_resource *upstream = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (!batches_.empty()) {
+                const Batch b = batches_.back();
+                batches_.pop_back();
+                depotNodes_ -= b.count;
+                if (depotNodes_ <= watermark_)
+                    trimAt_ = watermark_; // 回到水位线以下，取消退避
+                return b;
+            }
+            const auto grow = static_cast<size_t>(static_cast<double>(capacity_) * (policy_.factor - 1));
+            n = std::clamp(grow, policy_.initial, std::max(policy_.initial, policy_.max));
+            upstream = upstream_;
+        }
+
+        // 申请内存不占锁；按 Node 的对齐要求分配
+        Node *block = static_cast<Node *>(upstream != nullptr
+                                              ? upstream->allocate(n * sizeof(Node), alignof(Node))
+                                              : ::operator new(n * sizeof(Node), std::align_val_t{alignof(Node)}));
+        Batch first;
+        std::lock_guard<std::mutex> lock(mtx_);
+        const auto pos = std::upper_bound(chunks_.begin(), chunks_.end(), block,
+                                          [](const Node *p, const Chunk &c) { return std::less<>()(p, c.begin); });
+        chunks_.insert(pos, Chunk{block, n, upstream});
+        capacity_ += n;
+        for (size_t begin = 0; begin < n; begin += BATCH_SIZE) {
+            const size_t count = std::min(BATCH_SIZE, n - begin);
+            for (size_t i = begin; i < begin + count - 1; ++i)
+                block[i].next = &block[i + 1];
+            block[begin + count - 1].next = nullptr;
+            if (begin == 0) {
+                first = {block, count};
+            } else {
+                batches_.push_back({&block[begin], count});
+                depotNodes_ += count;
+            }
+        }
+        return first;
+    }
+
+    // 节点所在块的下标（chunks_ 按起始地址排序）
+    size_t chunk_of(const Node *node) const {
+        const auto it = std::upper_bound(chunks_.begin(), chunks_.end(), node,
+                                         [](const Node *p, const Chunk &c) { return std::less<>()(p, c.begin); });
+        return static_cast<size_t>(it - chunks_.begin()) - 1;
+    }
+
+    // 统计仓库中每块的空闲节点数，整块空闲的释放掉，其余节点重新分批
+    size_t trim_locked() {
+        std::vector<size_t> freeCount(chunks_.size(), 0);
+        std::vector<std::pair<Node *, size_t>> nodes;
+        nodes.reserve(depotNodes_);
+        for (const Batch &b : batches_) {
+            for (Node *n = b.head; n != nullptr; n = n->next) {
+                const size_t idx = chunk_of(n);
+                ++freeCount[idx];
+                nodes.emplace_back(n, idx);
+            }
+        }
+
+        size_t released = 0;
+        std::vector<bool> drop(chunks_.size(), false);
+        for (size_t i = 0; i < chunks_.size(); ++i) {
+            drop[i] = freeCount[i] == chunks_[i].count;
+            if (drop[i])
+                released += chunks_[i].count;
+        }
+        if (released > 0) {
+            batches_.clear();
+            Batch cur;
+            for (const auto &[n, idx] : nodes) {
+                if (drop[idx])
+                    continue;
+                n->next = cur.head;
+                cur.head = n;
+                if (++cur.count == BATCH_SIZE) {
+                    batches_.push_back(cur);
+                    cur = Batch{};
+                }
+            }
+            if (cur.count > 0)
+                batches_.push_back(cur);
+
+            std::vector<Chunk> kept;
+            for (size_t i = 0; i < chunks_.size(); ++i) {
+                if (drop[i])
+                    free_chunk(chunks_[i]);
+                else
+                    kept.push_back(chunks_[i]);
+            }
+            chunks_.swap(kept);
+            capacity_ -= released;
+            depotNodes_ -= released;
+        }
+        trimAt_ = released > 0 ? watermark_ : backoff_trim_at();
+        return released;
+    }
+
+    // trim 一块都没回收（碎片化）：再积累水位线的 1/8 再扫描，避免每次归还都扫描一遍仓库；
+    // 扫描一次 O(仓库大小)，均摊到每个归还的节点上是常数
+    [[nodiscard]] size_t backoff_trim_at() const {
+        return watermark_ == NO_WATERMARK ? NO_WATERMARK : depotNodes_ + std::max(watermark_ / 8, BATCH_SIZE);
+    }
+
+    static void free_chunk(const Chunk &c) {
+        if (c.upstream != nullptr)
+            c.upstream->deallocate(c.begin, c.count * sizeof(Node), alignof(Node));
+        else
+            ::operator delete(c.begin, std::align_val_t{alignof(Node)});
+    }
+
+    std::mutex mtx_;
+    std::vector<Batch> batches_;
+    std::vector<Chunk> chunks_;
+    std::vector<Cache *> caches_;
+    size_t depotNodes_ = 0;
+    size_t capacity_ = 0;
+    GrowthPolicy policy_;
+    std::pmr::memory_resource *upstream_ = nullptr;
+    size_t watermark_ = NO_WATERMARK;
+    size_t trimAt_ = NO_WATERMARK; // 仓库空闲节点超过它就自动 trim：平时等于水位线，碎片化时退避
+};
+
+template<typename T>
+class Queue {
+public:
+    struct Node {
+        // 数据 + 指针
+        T data;
+        Node *next;
+
+        explicit Node(const T &d) : data(d), next(nullptr) {
+        }
+
+        // 每种节点类型一个池；所有 Queue<T> 共用
+        static NodePool<Node> &pool() {
+            static NodePool<Node> p;
+            return p;
+        }
+
+        // 重载 new/delete：从对象池获取/归还节点
+        void *operator new(const size_t) {
+            return pool().allocate();
+        }
+
+        void operator delete(void *ptr) {
+            pool().deallocate(ptr);
+        }
+    };
+
+    // 构造：创建哨兵节点
+    Queue() {
+        head = tail = new Node(T());
+    }
+
+    // 析构：删除所有节点
+    ~Queue() {
+        while (!empty()) dequeue();
+        delete head;
+    }
+
+    // 入队：尾插
+    void enqueue(const T &data) {
+        Node *node = new Node(data);
+        tail->next = node;
+        tail = node;
+    }
+
+    // 出队：头删
+    void dequeue() {
+        if (empty()) throw std::out_of_range("Queue is empty");
+
+        Node *first = head->next;
+        head->next = first->next;
+
+        if (first == tail)
+            tail = head;
+
+        delete first;
+    }
+
+    // 返回队头数据
+    [[nodiscard]] T front() const {
+        if (empty()) throw std::out_of_range("Queue is empty");
+        return head->next->data;
+    }
+
+    // 判空
+    [[nodiscard]] bool empty() const {
+        return head == tail;
+    }
+
+private:
+    Node *head; // 哨兵节点
+    Node *tail; // 最后一个真实节点
+};
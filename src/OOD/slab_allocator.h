@@ -0,0 +1,411 @@
+#pragma once
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+/*
+按尺寸分级的 slab 小对象分配器
+  m_string.cpp 里的 my_operator_new 只是在 malloc 外面打印日志，这里是一个真正的小对象分配器。
+
+  尺寸分级：16..128 每 16 字节一级，之后每个 2 的幂区间分 4 级（160, 192, 224, 256, 320 ...），
+  一直到 4096，共 28 级；内部碎片不超过 25%。超过 4KB 的请求直接交给 malloc。
+
+  span：启动时保留一大段虚拟地址（只保留不提交，真正写到的页才占物理内存），
+  每次切出一个 64KB 的 span 专门给某一级使用，切成等长的对象。
+  指针属于哪个 span、哪一级，用 (p - base) / 64KB 查一张表即可，不需要对象头；
+  地址不在保留区间内的指针就是 malloc 分配的，释放时交还 free。
+
+  线程缓存：每个线程每一级一条空闲链表，常见路径无锁；
+  空了从中心空闲表整批拿，多于两批就整批还回去（与 pooled_queue.h 的 NodePool 相同）。
+  线程退出时缓存还给中心；之后该线程上的分配直接走中心（加锁）。
+
+  用法：
+    slab::allocate / slab::deallocate             直接调用
+    slab::StdAllocator<T>                         给标准容器用
+    在某一个 .cpp 里 #define SLAB_REPLACE_GLOBAL_NEW 再包含本头文件，
+    就用它替换整个程序的全局 operator new/delete（只能有一个翻译单元这样做）。
+  对齐：所有对象按 16 字节对齐；更大的对齐要求交给 aligned_alloc。
+*/
+namespace slab {
+
+constexpr size_t kMaxSize = 4096;
+constexpr size_t kSpanSize = 64 * 1024;
+constexpr size_t kRegionSize = size_t{16} << 30; // 保留 16GB 虚拟地址
+constexpr size_t kMinAlign = 16;
+constexpr size_t kNumClasses = 28;
+
+namespace detail {
+
+struct FreeObj {
+    FreeObj *next;
+};
+
+// 中心空闲表里的一整批：批首对象的第二个字存下一批
+struct BatchHead {
+    FreeObj *next;
+    BatchHead *nextBatch;
+};
+
+constexpr size_t class_size(const size_t cls) {
+    if (cls < 8)
+        return (cls + 1) * 16;
+    const size_t group = (cls - 8) / 4; // 0 -> (128, 256]
+    const size_t base = size_t{128} << group;
+    return base + base / 4 * ((cls - 8) % 4 + 1);
+}
+
+constexpr size_t class_of(const size_t size) {
+    if (size <= 128)
+        return size == 0 ? 0 : (size + 15) / 16 - 1;
+    const size_t lg = std::bit_width(size - 1) - 1; // floor(log2(size - 1))
+    const size_t base = size_t{1} << lg;
+    const size_t step = base / 4;
+    const size_t offset = (size - base + step - 1) / step; // 1..4
+    return 8 + (lg - 7) * 4 + offset - 1;
+}
+
+static_assert(class_size(kNumClasses - 1) == kMaxSize);
+static_assert(class_of(129) == 8 && class_size(8) == 160);
+static_assert(class_of(4096) == kNumClasses - 1);
+
+// 每批对象数：小对象多搬一些，大对象少搬一些
+constexpr uint32_t batch_of(const size_t cls) {
+    return static_cast<uint32_t>(std::clamp<size_t>(8192 / class_size(cls), 4, 128));
+}
+
+struct Central {
+    std::mutex mtx;
+    BatchHead *full = nullptr; // 满批
+    FreeObj *loose = nullptr;  // 零散对象（线程退出时归还的）
+    uint32_t looseCount = 0;
+};
+
+// 全部是平凡析构的类型，线程退出后仍然可以安全访问
+struct ThreadCache {
+    FreeObj *head[kNumClasses];
+    uint32_t count[kNumClasses];
+    bool registered;
+    bool dead;
+};
+
+inline Central centrals[kNumClasses];
+inline std::atomic<char *> regionBase{nullptr};
+inline std::atomic<size_t> spansUsed{0};
+inline uint8_t spanClass[kRegionSize / kSpanSize];
+inline thread_local ThreadCache cache;
+
+inline void flush_cache();
+
+// 线程退出时把缓存交还中心
+struct CacheReaper {
+    ~CacheReaper() { flush_cache(); }
+};
+
+inline thread_local CacheReaper reaper;
+
+inline char *region() {
+    char *base = regionBase.load(std::memory_order_acquire);
+    if (base != nullptr)
+        return base;
+    // 多映射一个 span 用来对齐；MAP_NORESERVE：只保留地址，不预先提交
+    void *raw = mmap(nullptr, kRegionSize + kSpanSize, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (raw == MAP_FAILED)
+        return nullptr;
+    auto aligned = reinterpret_cast<char *>((reinterpret_cast<uintptr_t>(raw) + kSpanSize - 1) & ~(kSpanSize - 1));
+    if (!regionBase.compare_exchange_strong(base, aligned)) {
+        munmap(raw, kRegionSize + kSpanSize); // 别的线程先完成了
+        return base;
+    }
+    return aligned;
+}
+
+// 调用者持有 centrals[cls].mtx：切一个新 span，挂成若干满批，返回第一批
+inline FreeObj *carve_span(const size_t cls, uint32_t &count) {
+    char *base = region();
+    if (base == nullptr)
+        return nullptr;
+    const size_t idx = spansUsed.fetch_add(1, std::memory_order_relaxed);
+    if (idx >= kRegionSize / kSpanSize)
+        return nullptr;
+    spanClass[idx] = static_cast<uint8_t>(cls);
+    char *span = base + idx * kSpanSize;
+
+    const size_t size = class_size(cls);
+    const size_t n = kSpanSize / size;
+    const uint32_t batch = batch_of(cls);
+    Central &c = centrals[cls];
+    FreeObj *first = nullptr;
+    for (size_t begin = 0; begin < n; begin += batch) {
+        const size_t end = std::min(n, begin + batch);
+        for (size_t i = begin; i < end; ++i) {
+            auto *obj = reinterpret_cast<FreeObj *>(span + i * size);
+            obj->next = i + 1 < end ? reinterpret_cast<FreeObj *>(span + (i + 1) * size) : nullptr;
+        }
+        auto *head = reinterpret_cast<FreeObj *>(span + begin * size);
+        if (begin == 0) {
+            first = head;
+            count = static_cast<uint32_t>(end - begin);
+        } else if (end - begin == batch) {
+            auto *b = reinterpret_cast<BatchHead *>(head);
+            b->nextBatch = c.full;
+            c.full = b;
+        } else {
+            FreeObj *tail = reinterpret_cast<FreeObj *>(span + (end - 1) * size);
+            tail->next = c.loose;
+            c.loose = head;
+            c.looseCount += static_cast<uint32_t>(end - begin);
+        }
+    }
+    return first;
+}
+
+// 从中心取一批：满批 > 零散对象 > 新 span
+inline FreeObj *fetch(const size_t cls, uint32_t &count) {
+    Central &c = centrals[cls];
+    std::lock_guard<std::mutex> lock(c.mtx);
+    if (c.full != nullptr) {
+        BatchHead *b = c.full;
+        c.full = b->nextBatch;
+        count = batch_of(cls);
+        return reinterpret_cast<FreeObj *>(b);
+    }
+    if (c.loose != nullptr) {
+        FreeObj *list = c.loose;
+        count = c.looseCount;
+        c.loose = nullptr;
+        c.looseCount = 0;
+        return list;
+    }
+    return carve_span(cls, count);
+}
+
+// 还一整批（恰好 batch_of(cls) 个）
+inline void release_batch(const size_t cls, FreeObj *head) {
+    Central &c = centrals[cls];
+    auto *b = reinterpret_cast<BatchHead *>(head);
+    std::lock_guard<std::mutex> lock(c.mtx);
+    b->nextBatch = c.full;
+    c.full = b;
+}
+
+// 还若干个零散对象
+inline void release_loose(const size_t cls, FreeObj *head, FreeObj *tail, const uint32_t n) {
+    Central &c = centrals[cls];
+    std::lock_guard<std::mutex> lock(c.mtx);
+    tail->next = c.loose;
+    c.loose = head;
+    c.looseCount += n;
+}
+
+inline void flush_cache() {
+    ThreadCache &tc = cache;
+    for (size_t cls = 0; cls < kNumClasses; ++cls) {
+        FreeObj *head = tc.head[cls];
+        if (head == nullptr)
+            continue;
+        FreeObj *tail = head;
+        while (tail->next != nullptr)
+            tail = tail->next;
+        release_loose(cls, head, tail, tc.count[cls]);
+        tc.head[cls] = nullptr;
+        tc.count[cls] = 0;
+    }
+    tc.dead = true;
+}
+
+// 第一次使用线程缓存时登记线程退出回调；分配和释放两条路径都要登记，
+// 否则一个只释放不分配的线程（跨线程释放的消费者）退出时缓存里的对象就丢了
+inline void register_thread(ThreadCache &tc) {
+    if (!tc.registered) {
+        tc.registered = true;
+        (void)&reaper;
+    }
+}
+
+// 超过 kMaxSize 的块来自 malloc，交还 free。
+// 不内联：替换全局 operator delete 时，内联进去的 free 会被 GCC 当成
+// "new 出来的指针交给 free" 报 -Wmismatched-new-delete，而这里的指针确实来自 malloc
+[[gnu::noinline]] inline void free_large(void *p) {
+    std::free(p);
+}
+
+inline void *allocate_small(const size_t cls) {
+    ThreadCache &tc = cache;
+    if (tc.dead) {
+        // 线程正在退出：不再使用缓存，直接从中心拿一个
+        uint32_t n = 0;
+        FreeObj *list = fetch(cls, n);
+        if (list == nullptr)
+            return nullptr;
+        if (n > 1) {
+            FreeObj *tail = list->next;
+            while (tail->next != nullptr)
+                tail = tail->next;
+            release_loose(cls, list->next, tail, n - 1);
+        }
+        return list;
+    }
+    register_thread(tc);
+    FreeObj *obj = tc.head[cls];
+    if (obj == nullptr) {
+        uint32_t n = 0;
+        obj = fetch(cls, n);
+        if (obj == nullptr)
+            return nullptr;
+        tc.count[cls] = n;
+    }
+    tc.head[cls] = obj->next;
+    --tc.count[cls];
+    return obj;
+}
+
+inline void deallocate_small(void *p, const size_t cls) {
+    ThreadCache &tc = cache;
+    auto *obj = static_cast<FreeObj *>(p);
+    if (tc.dead) {
+        obj->next = nullptr;
+        release_loose(cls, obj, obj, 1);
+        return;
+    }
+    register_thread(tc);
+    obj->next = tc.head[cls];
+    tc.head[cls] = obj;
+    const uint32_t batch = batch_of(cls);
+    if (++tc.count[cls] > 2 * batch) {
+        // 多出来的一批还给中心
+        FreeObj *last = obj;
+        for (uint32_t i = 1; i < batch; ++i)
+            last = last->next;
+        tc.head[cls] = last->next;
+        last->next = nullptr;
+        tc.count[cls] -= batch;
+        release_batch(cls, obj);
+    }
+}
+
+} // namespace detail
+
+// p 是否由 slab 分配（否则来自 malloc）
+inline bool owns(const void *p) {
+    const char *base = detail::regionBase.load(std::memory_order_relaxed);
+    const auto *c = static_cast<const char *>(p);
+    return base != nullptr && c >= base && c < base + kRegionSize;
+}
+
+// 分配 size 字节；失败返回 nullptr，不抛异常
+inline void *allocate(const size_t size) {
+    if (size <= kMaxSize) {
+        if (void *p = detail::allocate_small(detail::class_of(size)))
+            return p;
+    }
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+inline void deallocate(void *p) {
+    if (p == nullptr)
+        return;
+    if (owns(p)) {
+        const size_t span = static_cast<size_t>(static_cast<char *>(p) - detail::regionBase.load()) / kSpanSize;
+        detail::deallocate_small(p, detail::spanClass[span]);
+    } else {
+        detail::free_large(p);
+    }
+}
+
+inline void *allocate_aligned(const size_t size, const size_t align) {
+    if (align <= kMinAlign)
+        return allocate(size);
+    return std::aligned_alloc(align, (std::max(size, align) + align - 1) & ~(align - 1));
+}
+
+// 已经切出的 span 数与字节数
+inline size_t span_count() {
+    return std::min(detail::spansUsed.load(), kRegionSize / kSpanSize);
+}
+
+inline size_t span_bytes() {
+    return span_count() * kSpanSize;
+}
+
+// 给标准容器用的配置器
+template<typename T>
+struct StdAllocator {
+    using value_type = T;
+
+    StdAllocator() = default;
+
+    template<typename U>
+    StdAllocator(const StdAllocator<U> &) {
+    }
+
+    T *allocate(const size_t n) {
+        void *p = allocate_aligned(n * sizeof(T), alignof(T));
+        if (p == nullptr)
+            throw std::bad_alloc();
+        return static_cast<T *>(p);
+    }
+
+    void deallocate(T *p, size_t) {
+        slab::deallocate(p);
+    }
+
+    template<typename U>
+    bool operator==(const StdAllocator<U> &) const {
+        return true;
+    }
+};
+
+} // namespace slab
+
+#ifdef SLAB_REPLACE_GLOBAL_NEW
+// 替换全局 operator new/delete：只能在一个翻译单元里定义 SLAB_REPLACE_GLOBAL_NEW
+
+void *operator new(size_t size) {
+    if (void *p = slab::allocate(size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](size_t size) {
+    return ::operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+    return slab::allocate(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+    return slab::allocate(size);
+}
+
+void *operator new(size_t size, std::align_val_t align) {
+    if (void *p = slab::allocate_aligned(size, static_cast<size_t>(align)))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](size_t size, std::align_val_t align) {
+    return ::operator new(size, align);
+}
+
+void operator delete(void *p) noexcept { slab::deallocate(p); }
+void operator delete[](void *p) noexcept { slab::deallocate(p); }
+void operator delete(void *p, size_t) noexcept { slab::deallocate(p); }
+void operator delete[](void *p, size_t) noexcept { slab::deallocate(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { slab::deallocate(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { slab::deallocate(p); }
+void operator delete(void *p, std::align_val_t) noexcept { slab::deallocate(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { slab::deallocate(p); }
+void operator delete(void *p, size_t, std::align_val_t) noexcept { slab::deallocate(p); }
+void operator delete[](void *p, size_t, std::align_val_t) noexcept { slab::deallocate(p); }
+
+#endif
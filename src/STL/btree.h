@@ -0,0 +1,800 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "templates_vector.h"
+
+// ======================================================
+// B 树：BTreeMap<K, V> / BTreeSet<K>（及允许重复键的 Multi 版本），std::map / std::set 的缓存友好替代品
+// 红黑树每个节点只放一个元素，100 万个元素的树高约 20~40 层，查找一路都是指针跳转。
+// B 树的一个节点放一批有序的元素（默认按 256 字节、即 4 个缓存行来定节点容量，节点按 64 字节对齐）：
+//   - 100 万个 uint64_t 键的树只有 4~5 层，每层在一个节点内二分，相邻的比较都落在同一组缓存行里
+//   - 分配次数少一个数量级，顺序遍历时节点内是连续数组
+//   - 适合插入、删除、查找混合的场景（只读为主用 flat_map.h 的 FlatMap 更快）
+// 实现按《算法导论》第 18 章：最小度数 t，每个节点 t-1 ~ 2t-1 个元素（根节点可以更少）；
+// 插入时自顶向下拆分满节点，只需一趟下降；删除先定位元素，内部节点的元素用前驱顶替，
+// 从叶子删掉一个之后自底向上向兄弟借或与兄弟合并。
+// 叶子节点不带子节点指针数组，省掉约三分之一的空间。
+// 同一棵树也支持重复键：BTreeMultiMap / BTreeMultiSet，相等的元素按插入顺序排列。
+// 注意：插入和删除会在节点之间移动元素，迭代器和元素引用随之失效（与 std::map 不同）。
+// 参数引用树里的元素是安全的（m[it->first]、m.erase(m.begin()->first)）：插入在任何拆分之前
+// 先查找并构造好新元素，删除在定位之后不再使用 key。
+// ======================================================
+namespace btree_detail {
+
+template<typename Slot, typename KeyOf, typename Compare, size_t NodeBytes>
+class Tree {
+    // 每个节点最多 kMax = 2t - 1 个元素：减去节点头之后能放下几个就放几个，至少 3 个，取奇数
+    // 元素比节点还大时 kFit 为 0，不能再减一（无符号回绕），直接取 3
+    static constexpr size_t kFit = NodeBytes > 16 ? (NodeBytes - 16) / sizeof(Slot) : 0;
+    static constexpr size_t kMax = kFit < 3 ? 3 : (kFit % 2 == 1 ? kFit : kFit - 1);
+    static constexpr size_t kMin = (kMax + 1) / 2; // 最小度数 t
+    static_assert(kMax < 256, "node slot count must fit in uint8_t");
+
+public:
+    // 叶子节点：元素的未初始化存储
+    struct alignas(64) Leaf {
+        Leaf *parent = nullptr;
+        uint8_t position = 0; // 在父节点 children 中的下标
+        uint8_t count = 0;
+        bool leaf = true;
+        alignas(Slot) unsigned char storage[kMax * sizeof(Slot)];
+
+        Slot *slots() { return reinterpret_cast<Slot *>(storage); }
+        Slot &slot(const size_t i) { return slots()[i]; }
+    };
+
+    // 内部节点：多一组子节点指针
+    struct Internal : Leaf {
+        Leaf *children[kMax + 1];
+
+        Internal() { this->leaf = false; }
+    };
+
+    using Node = Leaf;
+
+    // 双向迭代器：{树, 节点, 节点内下标}，end() 的节点为 nullptr
+    template<typename Ref>
+    class Iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = std::remove_cvref_t<Ref>;
+        using difference_type = std::ptrdiff_t;
+        using reference = Ref;
+        using pointer = std::remove_reference_t<Ref> *;
+
+        Iterator() = default;
+
+        Iterator(const Tree *tree, Node *node, const size_t index) : tree_(tree), node_(node), index_(index) {
+        }
+
+        // iterator -> const_iterator
+        template<typename R> requires (!std::is_same_v<R, Ref> && std::is_convertible_v<R, Ref>)
+        Iterator(const Iterator<R> &other) : tree_(other.tree_), node_(other.node_), index_(other.index_) {
+        }
+
+        reference operator*() const { return reinterpret_cast<reference>(node_->slot(index_)); }
+        pointer operator->() const { return &**this; }
+
+        // 中序后继：内部节点去右子树的最左叶子；叶子节点往后走，走完了往上找
+        Iterator &operator++() {
+            if (!node_->leaf) {
+                node_ = leftmost(child(node_, index_ + 1));
+                index_ = 0;
+                return *this;
+            }
+            if (++index_ < node_->count)
+                return *this;
+            while (node_->parent != nullptr) {
+                index_ = node_->position;
+                node_ = node_->parent;
+                if (index_ < node_->count)
+                    return *this;
+            }
+            node_ = nullptr; // 走过了最后一个元素
+            index_ = 0;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        Iterator &operator--() {
+            if (node_ == nullptr) {
+                node_ = rightmost(tree_->root_);
+                index_ = node_->count - 1;
+                return *this;
+            }
+            if (!node_->leaf) {
+                node_ = rightmost(child(node_, index_));
+                index_ = node_->count - 1;
+                return *this;
+            }
+            if (index_ > 0) {
+                --index_;
+                return *this;
+            }
+            while (node_->position == 0)
+                node_ = node_->parent;
+            index_ = node_->position - 1;
+            node_ = node_->parent;
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            Iterator old = *this;
+            --*this;
+            return old;
+        }
+
+        bool operator==(const Iterator &other) const { return node_ == other.node_ && index_ == other.index_; }
+
+    private:
+        friend class Tree;
+        template<typename R>
+        friend class Iterator;
+        const Tree *tree_ = nullptr;
+        Node *node_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    Tree() = default;
+
+    Tree(const Tree &other) : comp_(other.comp_) {
+        for (auto it = other.template begin<const Slot &>(); it != other.template end<const Slot &>(); ++it)
+            insert_value(Slot(*it));
+    }
+
+    Tree(Tree &&other) noexcept : comp_(other.comp_) {
+        swap(other);
+    }
+
+    Tree &operator=(const Tree &other) {
+        if (this == &other)
+            return *this;
+        Tree copy(other);
+        swap(copy);
+        return *this;
+    }
+
+    Tree &operator=(Tree &&other) noexcept {
+        Tree moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    ~Tree() { free_subtree(root_); }
+
+    void swap(Tree &other) noexcept {
+        std::swap(root_, other.root_);
+        std::swap(size_, other.size_);
+        std::swap(comp_, other.comp_);
+    }
+
+    [[nodiscard]] size_t size() const { return size_; }
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+
+    void clear() {
+        free_subtree(root_);
+        root_ = nullptr;
+        size_ = 0;
+    }
+
+    // 树高（空树为 0）
+    [[nodiscard]] size_t height() const {
+        size_t h = 0;
+        for (Node *n = root_; n != nullptr; n = n->leaf ? nullptr : child(n, 0))
+            ++h;
+        return h;
+    }
+
+    [[nodiscard]] static constexpr size_t node_capacity() { return kMax; }
+
+    template<typename Ref>
+    Iterator<Ref> begin() const { return root_ == nullptr ? end<Ref>() : Iterator<Ref>(this, leftmost(root_), 0); }
+
+    template<typename Ref>
+    Iterator<Ref> end() const { return Iterator<Ref>(this, nullptr, 0); }
+
+    // ----------------------------
+    // 查找：每层在节点内二分，定位第一个不小于 key 的元素
+    // ----------------------------
+    template<typename Ref, typename Q>
+    Iterator<Ref> find(const Q &key) const {
+        const auto [n, i] = find_pos(key);
+        return n == nullptr ? end<Ref>() : Iterator<Ref>(this, n, i);
+    }
+
+    // 第一个不小于（Upper 为 true 时：大于）key 的元素。路上记下最近一个"往左走"的位置，
+    // 到叶子都没找到时它就是答案
+    template<typename Ref, bool Upper, typename Q>
+    Iterator<Ref> bound(const Q &key) const {
+        Iterator<Ref> result = end<Ref>();
+        Node *n = root_;
+        while (n != nullptr) {
+            const size_t i = Upper ? upper_index(n, key) : lower_index(n, key);
+            if (i < n->count)
+                result = Iterator<Ref>(this, n, i);
+            n = n->leaf ? nullptr : child(n, i);
+        }
+        return result;
+    }
+
+    // ----------------------------
+    // 插入：key 不存在时用 args 构造新元素；返回 {元素所在的 (节点, 下标), 是否新插入}
+    // 先查找再拆分：key 或 args 可能引用树里的元素（m[it->first]），拆分会把它搬走
+    // ----------------------------
+    template<typename Q, typename... Args>
+    std::pair<std::pair<Node *, size_t>, bool> emplace_unique(const Q &key, Args &&... args) {
+        const auto found = find_pos(key);
+        if (found.first != nullptr)
+            return {found, false};
+        return {insert_value(Slot(std::forward<Args>(args)...)), true};
+    }
+
+    // 允许重复键：插在相等元素的后面
+    template<typename... Args>
+    std::pair<Node *, size_t> emplace_multi(Args &&... args) {
+        return insert_value(Slot(std::forward<Args>(args)...));
+    }
+
+    // ----------------------------
+    // 删除
+    // ----------------------------
+    template<typename Q>
+    size_t erase_unique(const Q &key) {
+        const auto [n, i] = find_pos(key);
+        if (n == nullptr)
+            return 0;
+        erase_at(n, i);
+        return 1;
+    }
+
+    // 删掉所有等于 key 的元素：先把键拷贝出来（key 可能就引用着要删的元素），再逐个删
+    template<typename Q>
+    size_t erase_multi(const Q &key) {
+        const auto first = bound<const Slot &, false>(key);
+        if (first == end<const Slot &>() || comp_(key, KeyOf()(*first)))
+            return 0;
+        const Key copy = KeyOf()(*first);
+        size_t erased = 0;
+        for (auto it = first; it != end<const Slot &>() && !comp_(copy, KeyOf()(*it)); ++it)
+            ++erased;
+        for (size_t k = 0; k < erased; ++k) {
+            const auto it = bound<const Slot &, false>(copy);
+            erase_at(it.node_, it.index_);
+        }
+        return erased;
+    }
+
+    // const_iterator -> iterator（容器自己的 erase(const_iterator) 用）
+    template<typename Ref, typename From>
+    static Iterator<Ref> rebind(const Iterator<From> &it) { return Iterator<Ref>(it.tree_, it.node_, it.index_); }
+
+    // 删掉 pos 处的元素，返回它的后继。删除会搬动元素，所以先记下后继的键，
+    // 以及它前面还有几个相等的键（重复键时），删完再按键找回来
+    template<typename Ref>
+    Iterator<Ref> erase(const Iterator<Ref> pos) {
+        Iterator<Ref> next = pos;
+        ++next;
+        if (next == end<Ref>()) {
+            erase_at(pos.node_, pos.index_);
+            return end<Ref>();
+        }
+        const Key nextKey = KeyOf()(*next);
+        size_t rank = 0;
+        for (auto it = bound<Ref, false>(nextKey); it != next; ++it)
+            ++rank;
+        if (!comp_(KeyOf()(*pos), nextKey))
+            --rank; // pos 自己就是 next 前面的一个相等元素
+        erase_at(pos.node_, pos.index_);
+        Iterator<Ref> it = bound<Ref, false>(nextKey);
+        while (rank-- > 0)
+            ++it;
+        return it;
+    }
+
+private:
+    Node *root_ = nullptr;
+    size_t size_ = 0;
+    [[no_unique_address]] Compare comp_;
+
+    using Key = std::remove_cvref_t<decltype(KeyOf()(std::declval<const Slot &>()))>;
+
+    static Node *&child(Node *n, const size_t i) { return static_cast<Internal *>(n)->children[i]; }
+
+    // 找到返回 (节点, 下标)，找不到返回 (nullptr, 0)
+    template<typename Q>
+    std::pair<Node *, size_t> find_pos(const Q &key) const {
+        Node *n = root_;
+        while (n != nullptr) {
+            const size_t i = lower_index(n, key);
+            if (i < n->count && !comp_(key, KeyOf()(n->slot(i))))
+                return {n, i};
+            n = n->leaf ? nullptr : child(n, i);
+        }
+        return {nullptr, 0};
+    }
+
+    // 自顶向下插入一个已经构造好的元素：沿途拆分满节点，插在相等元素的后面
+    std::pair<Node *, size_t> insert_value(Slot &&value) {
+        if (root_ == nullptr)
+            root_ = new Leaf;
+        if (root_->count == kMax) {
+            // 根满了：新根只有一个子节点，再拆分它，树长高一层
+            auto *top = new Internal;
+            top->children[0] = root_;
+            root_->parent = top;
+            root_->position = 0;
+            root_ = top;
+            split_child(top, 0);
+        }
+        const auto &key = KeyOf()(value);
+        Node *n = root_;
+        while (true) {
+            size_t i = upper_index(n, key);
+            if (n->leaf) {
+                insert_slot(n, i, std::move(value));
+                ++size_;
+                return {n, i};
+            }
+            if (child(n, i)->count == kMax) {
+                split_child(n, i); // 中位数上移到 n 的 i 处
+                if (!comp_(key, KeyOf()(n->slot(i))))
+                    ++i;
+            }
+            n = child(n, i);
+        }
+    }
+
+    // 删掉 n 的第 i 个元素。内部节点的元素用前驱（左子树最右叶子的最后一个元素）顶替，
+    // 于是总是从叶子删；叶子不足 t-1 个元素时向兄弟借，借不到就合并，合并可能让父节点不足，继续往上
+    void erase_at(Node *n, size_t i) {
+        if (!n->leaf) {
+            Node *leaf = rightmost(child(n, i));
+            n->slot(i) = std::move(leaf->slot(leaf->count - 1));
+            n = leaf;
+            i = leaf->count - 1;
+        }
+        remove_slot(n, i);
+        --size_;
+        while (n != root_ && n->count < kMin - 1) {
+            Node *parent = n->parent;
+            const size_t pos = n->position;
+            const bool canBorrow = (pos > 0 && child(parent, pos - 1)->count >= kMin) ||
+                                   (pos < parent->count && child(parent, pos + 1)->count >= kMin);
+            fill_child(parent, pos);
+            if (canBorrow)
+                break;
+            n = parent;
+        }
+        shrink_root();
+    }
+
+    static Node *leftmost(Node *n) {
+        while (!n->leaf)
+            n = child(n, 0);
+        return n;
+    }
+
+    static Node *rightmost(Node *n) {
+        while (!n->leaf)
+            n = child(n, n->count);
+        return n;
+    }
+
+    // 节点内二分
+    template<typename Q>
+    size_t lower_index(Node *n, const Q &key) const {
+        size_t lo = 0, hi = n->count;
+        while (lo < hi) {
+            const size_t mid = (lo + hi) / 2;
+            if (comp_(KeyOf()(n->slot(mid)), key))
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    template<typename Q>
+    size_t upper_index(Node *n, const Q &key) const {
+        size_t lo = 0, hi = n->count;
+        while (lo < hi) {
+            const size_t mid = (lo + hi) / 2;
+            if (comp_(key, KeyOf()(n->slot(mid))))
+                hi = mid;
+            else
+                lo = mid + 1;
+        }
+        return lo;
+    }
+
+    // ----------------------------
+    // 节点内的元素移动：槽位 [0, count) 已构造，其余是未初始化的存储
+    // ----------------------------
+    template<typename... Args>
+    static void insert_slot(Node *n, const size_t i, Args &&... args) {
+        Slot *s = n->slots();
+        if (i == n->count) {
+            ::new(static_cast<void *>(s + i)) Slot(std::forward<Args>(args)...);
+        } else {
+            Slot value(std::forward<Args>(args)...);
+            ::new(static_cast<void *>(s + n->count)) Slot(std::move(s[n->count - 1]));
+            std::move_backward(s + i, s + n->count - 1, s + n->count);
+            s[i] = std::move(value);
+        }
+        ++n->count;
+    }
+
+    static void remove_slot(Node *n, const size_t i) {
+        Slot *s = n->slots();
+        std::move(s + i + 1, s + n->count, s + i);
+        s[--n->count].~Slot();
+    }
+
+    // 把 src 的 [from, from + len) 搬到 dst 的 [at, at + len)（dst 这段是未初始化的）
+    static void relocate(Node *src, const size_t from, const size_t len, Node *dst, const size_t at) {
+        Allocator<Slot> alloc;
+        relocate_elements(alloc, src->slots() + from, len, dst->slots() + at);
+    }
+
+    // 子节点 [first, last) 的父指针和下标重新指向 n
+    static void adopt(Node *n, const size_t first, const size_t last) {
+        for (size_t c = first; c < last; ++c) {
+            child(n, c)->parent = n;
+            child(n, c)->position = static_cast<uint8_t>(c);
+        }
+    }
+
+    // 在 children 里插入第 i 个子节点（在 count 加一之前调用）/ 删掉第 i 个（在 count 减一之后调用）
+    static void insert_child(Node *n, const size_t i, Node *c) {
+        Node **cs = static_cast<Internal *>(n)->children;
+        std::move_backward(cs + i, cs + n->count + 1, cs + n->count + 2);
+        cs[i] = c;
+    }
+
+    static void remove_child(Node *n, const size_t i) {
+        Node **cs = static_cast<Internal *>(n)->children;
+        std::move(cs + i + 1, cs + n->count + 2, cs + i);
+    }
+
+    // n 的第 i 个子节点满了（2t-1 个元素）：后 t-1 个元素搬到新节点，中位数上移到 n
+    void split_child(Node *n, const size_t i) {
+        Node *full = child(n, i);
+        Node *fresh = full->leaf ? new Leaf : static_cast<Node *>(new Internal);
+        relocate(full, kMin, kMin - 1, fresh, 0);
+        fresh->count = kMin - 1;
+        if (!full->leaf) {
+            std::copy(&child(full, kMin), &child(full, kMin) + kMin, &child(fresh, 0));
+            adopt(fresh, 0, kMin);
+        }
+        full->count = kMin - 1;
+
+        // 中位数 full[t-1] 上移：n 的 [i, count) 右移一格
+        insert_child(n, i + 1, fresh);
+        Slot *s = n->slots();
+        if (i == n->count) {
+            relocate(full, kMin - 1, 1, n, i);
+        } else {
+            ::new(static_cast<void *>(s + n->count)) Slot(std::move(s[n->count - 1]));
+            std::move_backward(s + i, s + n->count - 1, s + n->count);
+            s[i] = std::move(full->slot(kMin - 1));
+            full->slot(kMin - 1).~Slot();
+        }
+        ++n->count;
+        adopt(n, i + 1, n->count + 1);
+    }
+
+    // 把 n 的第 i 个元素和第 i+1 个子节点并入第 i 个子节点（两个子节点合起来不超过 2t-2 个元素）
+    void merge_children(Node *n, const size_t i) {
+        Node *left = child(n, i), *right = child(n, i + 1);
+        ::new(static_cast<void *>(left->slots() + left->count)) Slot(std::move(n->slot(i)));
+        relocate(right, 0, right->count, left, left->count + 1);
+        if (!left->leaf) {
+            std::copy(&child(right, 0), &child(right, 0) + right->count + 1, &child(left, left->count + 1));
+            adopt(left, left->count + 1, left->count + right->count + 2);
+        }
+        left->count += right->count + 1;
+        right->count = 0;
+        delete_node(right);
+
+        remove_slot(n, i);
+        remove_child(n, i + 1);
+        adopt(n, i + 1, n->count + 1);
+    }
+
+    // 补足 n 的第 i 个子节点：先向左右兄弟借一个，借不到就与兄弟合并；返回补足后的子节点
+    Node *fill_child(Node *n, const size_t i) {
+        Node *c = child(n, i);
+        if (c->count >= kMin)
+            return c;
+        if (i > 0 && child(n, i - 1)->count >= kMin) {
+            // 向左兄弟借：n[i-1] 下移到 c 的最前面，左兄弟的最后一个元素上移
+            Node *left = child(n, i - 1);
+            if (!c->leaf)
+                insert_child(c, 0, child(left, left->count));
+            insert_slot(c, 0, std::move(n->slot(i - 1)));
+            if (!c->leaf)
+                adopt(c, 0, c->count + 1);
+            n->slot(i - 1) = std::move(left->slot(left->count - 1));
+            left->slot(--left->count).~Slot();
+            return c;
+        }
+        if (i < n->count && child(n, i + 1)->count >= kMin) {
+            // 向右兄弟借：n[i] 下移到 c 的最后面，右兄弟的第一个元素上移
+            Node *right = child(n, i + 1);
+            insert_slot(c, c->count, std::move(n->slot(i)));
+            n->slot(i) = std::move(right->slot(0));
+            if (!c->leaf) {
+                child(c, c->count) = child(right, 0);
+                adopt(c, c->count, c->count + 1);
+            }
+            remove_slot(right, 0);
+            if (!right->leaf) {
+                remove_child(right, 0);
+                adopt(right, 0, right->count + 1);
+            }
+            return c;
+        }
+        if (i < n->count) {
+            merge_children(n, i);
+            return c;
+        }
+        merge_children(n, i - 1);
+        return child(n, i - 1);
+    }
+
+    // 根节点被合并空了：唯一的子节点成为新根，树矮一层
+    void shrink_root() {
+        if (root_->count > 0)
+            return;
+        Node *old = root_;
+        root_ = old->leaf ? nullptr : child(old, 0);
+        if (root_ != nullptr)
+            root_->parent = nullptr;
+        delete_node(old);
+    }
+
+    static void delete_node(Node *n) {
+        if (n->leaf)
+            delete n;
+        else
+            delete static_cast<Internal *>(n);
+    }
+
+    static void free_subtree(Node *n) {
+        if (n == nullptr)
+            return;
+        if (!n->leaf) {
+            for (size_t c = 0; c <= n->count; ++c)
+                free_subtree(child(n, c));
+        }
+        Allocator<Slot> alloc;
+        destroy_elements(alloc, n->slots(), n->slots() + n->count);
+        delete_node(n);
+    }
+};
+
+struct PairKey {
+    template<typename P>
+    const auto &operator()(const P &p) const { return p.first; }
+};
+
+struct SelfKey {
+    template<typename K>
+    const K &operator()(const K &k) const { return k; }
+};
+
+} // namespace btree_detail
+
+// ======================================================
+// BTreeMap<K, V> / BTreeMultiMap<K, V>：槽位里存 std::pair<K, V>，对外按 std::pair<const K, V> 访问
+// （两者布局相同），节点之间搬动元素时可以移动键而不是拷贝
+// ======================================================
+template<typename K, typename V, typename Compare, size_t NodeBytes, bool Multi>
+class BasicBTreeMap {
+    using Tree = btree_detail::Tree<std::pair<K, V>, btree_detail::PairKey, Compare, NodeBytes>;
+
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<const K, V>;
+    using iterator = typename Tree::template Iterator<value_type &>;
+    using const_iterator = typename Tree::template Iterator<const value_type &>;
+
+    [[nodiscard]] size_t size() const { return tree_.size(); }
+    [[nodiscard]] bool empty() const { return tree_.empty(); }
+    [[nodiscard]] size_t height() const { return tree_.height(); }
+    [[nodiscard]] static constexpr size_t node_capacity() { return Tree::node_capacity(); }
+    void clear() { tree_.clear(); }
+
+    // 重复键时返回其中任意一个（同 std::multimap）
+    template<typename Q>
+    iterator find(const Q &key) { return tree_.template find<value_type &>(key); }
+
+    template<typename Q>
+    const_iterator find(const Q &key) const { return tree_.template find<const value_type &>(key); }
+
+    template<typename Q>
+    iterator lower_bound(const Q &key) { return tree_.template bound<value_type &, false>(key); }
+
+    template<typename Q>
+    const_iterator lower_bound(const Q &key) const { return tree_.template bound<const value_type &, false>(key); }
+
+    template<typename Q>
+    iterator upper_bound(const Q &key) { return tree_.template bound<value_type &, true>(key); }
+
+    template<typename Q>
+    const_iterator upper_bound(const Q &key) const { return tree_.template bound<const value_type &, true>(key); }
+
+    template<typename Q>
+    std::pair<iterator, iterator> equal_range(const Q &key) { return {lower_bound(key), upper_bound(key)}; }
+
+    template<typename Q>
+    std::pair<const_iterator, const_iterator> equal_range(const Q &key) const {
+        return {lower_bound(key), upper_bound(key)};
+    }
+
+    template<typename Q>
+    bool contains(const Q &key) const { return find(key) != end(); }
+
+    template<typename Q>
+    size_t count(const Q &key) const {
+        if constexpr (Multi) {
+            const auto [first, last] = equal_range(key);
+            return std::distance(first, last);
+        } else {
+            return contains(key) ? 1 : 0;
+        }
+    }
+
+    template<typename Q>
+    V &at(const Q &key) requires (!Multi) {
+        const iterator it = find(key);
+        if (it == end())
+            throw std::out_of_range("BTreeMap::at: key not found");
+        return it->second;
+    }
+
+    // ----------------------------
+    // 插入：BTreeMap 键已存在时什么都不做；BTreeMultiMap 总是插入，排在相等的键后面
+    // ----------------------------
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(const K &key, Args &&... args) requires (!Multi) {
+        const auto [pos, inserted] = tree_.emplace_unique(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                                          std::forward_as_tuple(std::forward<Args>(args)...));
+        return {iterator(&tree_, pos.first, pos.second), inserted};
+    }
+
+    std::pair<iterator, bool> insert(const std::pair<K, V> &kv) requires (!Multi) {
+        return try_emplace(kv.first, kv.second);
+    }
+
+    V &operator[](const K &key) requires (!Multi) { return try_emplace(key).first->second; }
+
+    template<typename... Args>
+    iterator emplace(Args &&... args) requires Multi {
+        const auto [node, index] = tree_.emplace_multi(std::forward<Args>(args)...);
+        return iterator(&tree_, node, index);
+    }
+
+    iterator insert(const std::pair<K, V> &kv) requires Multi { return emplace(kv); }
+
+    // ----------------------------
+    // 删除：按键删掉所有相等的元素，返回个数；按迭代器删一个，返回它的后继
+    // ----------------------------
+    template<typename Q>
+    size_t erase(const Q &key) requires (!std::is_convertible_v<const Q &, const_iterator>) {
+        if constexpr (Multi)
+            return tree_.erase_multi(key);
+        else
+            return tree_.erase_unique(key);
+    }
+
+    iterator erase(const iterator pos) { return tree_.erase(pos); }
+    iterator erase(const const_iterator pos) { return tree_.erase(Tree::template rebind<value_type &>(pos)); }
+
+    iterator begin() { return tree_.template begin<value_type &>(); }
+    iterator end() { return tree_.template end<value_type &>(); }
+    const_iterator begin() const { return tree_.template begin<const value_type &>(); }
+    const_iterator end() const { return tree_.template end<const value_type &>(); }
+
+private:
+    Tree tree_;
+};
+
+template<typename K, typename V, typename Compare = std::less<>, size_t NodeBytes = 256>
+using BTreeMap = BasicBTreeMap<K, V, Compare, NodeBytes, false>;
+
+template<typename K, typename V, typename Compare = std::less<>, size_t NodeBytes = 256>
+using BTreeMultiMap = BasicBTreeMap<K, V, Compare, NodeBytes, true>;
+
+// ======================================================
+// BTreeSet<K> / BTreeMultiSet<K>：元素只读，iterator 与 const_iterator 相同
+// ======================================================
+template<typename K, typename Compare, size_t NodeBytes, bool Multi>
+class BasicBTreeSet {
+    using Tree = btree_detail::Tree<K, btree_detail::SelfKey, Compare, NodeBytes>;
+
+public:
+    using key_type = K;
+    using value_type = K;
+    using iterator = typename Tree::template Iterator<const K &>;
+    using const_iterator = iterator;
+
+    [[nodiscard]] size_t size() const { return tree_.size(); }
+    [[nodiscard]] bool empty() const { return tree_.empty(); }
+    [[nodiscard]] size_t height() const { return tree_.height(); }
+    [[nodiscard]] static constexpr size_t node_capacity() { return Tree::node_capacity(); }
+    void clear() { tree_.clear(); }
+
+    // BTreeSet 返回 {位置, 是否新插入}；BTreeMultiSet 总是插入，返回位置
+    auto insert(const K &key) {
+        if constexpr (Multi) {
+            const auto [node, index] = tree_.emplace_multi(key);
+            return iterator(&tree_, node, index);
+        } else {
+            const auto [pos, inserted] = tree_.emplace_unique(key, key);
+            return std::pair<iterator, bool>(iterator(&tree_, pos.first, pos.second), inserted);
+        }
+    }
+
+    template<typename Q>
+    iterator find(const Q &key) const { return tree_.template find<const K &>(key); }
+
+    template<typename Q>
+    iterator lower_bound(const Q &key) const { return tree_.template bound<const K &, false>(key); }
+
+    template<typename Q>
+    iterator upper_bound(const Q &key) const { return tree_.template bound<const K &, true>(key); }
+
+    template<typename Q>
+    std::pair<iterator, iterator> equal_range(const Q &key) const { return {lower_bound(key), upper_bound(key)}; }
+
+    template<typename Q>
+    bool contains(const Q &key) const { return find(key) != end(); }
+
+    template<typename Q>
+    size_t count(const Q &key) const {
+        if constexpr (Multi) {
+            const auto [first, last] = equal_range(key);
+            return std::distance(first, last);
+        } else {
+            return contains(key) ? 1 : 0;
+        }
+    }
+
+    template<typename Q>
+    size_t erase(const Q &key) requires (!std::is_convertible_v<const Q &, iterator>) {
+        if constexpr (Multi)
+            return tree_.erase_multi(key);
+        else
+            return tree_.erase_unique(key);
+    }
+
+    iterator erase(const iterator pos) { return tree_.erase(pos); }
+
+    iterator begin() const { return tree_.template begin<const K &>(); }
+    iterator end() const { return tree_.template end<const K &>(); }
+
+private:
+    Tree tree_;
+};
+
+template<typename K, typename Compare = std::less<>, size_t NodeBytes = 256>
+using BTreeSet = BasicBTreeSet<K, Compare, NodeBytes, false>;
+
+template<typename K, typename Compare = std::less<>, size_t NodeBytes = 256>
+using BTreeMultiSet = BasicBTreeSet<K, Compare, NodeBytes, true>;
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+// ======================================================
+// 连续内存容器（Vector / SmallVector）共用的迭代器
+// 本质就是包了一层的 T*，但补齐了标准要求的全部操作：
+//   - 类型别名：iterator_concept = contiguous_iterator_tag，iterator_category = random_access_iterator_tag
+//   - 解引用（可写）、->、[]；前置/后置 ++ --；+= -= + -；两个迭代器相减；== 与 <=>
+//   - ContiguousIterator<T> 可以隐式转换成 ContiguousIterator<const T>（iterator -> const_iterator），
+//     两者之间可以直接比较、相减
+// 这样 std::sort / std::lower_bound / std::ranges 算法 / C++17 并行算法都能直接用；
+// std::to_address(it) 拿到原始指针，可以交给需要指针的 SIMD 代码。
+// ======================================================
+template<typename T>
+class ContiguousIterator {
+public:
+    using iterator_concept = std::contiguous_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T *;
+    using reference = T &;
+
+    ContiguousIterator() = default;
+
+    explicit ContiguousIterator(T *ptr) : ptr_(ptr) {
+    }
+
+    // iterator -> const_iterator
+    template<typename U> requires std::is_convertible_v<U *, T *>
+    ContiguousIterator(const ContiguousIterator<U> &other) : ptr_(other.base()) {
+    }
+
+    [[nodiscard]] T *base() const { return ptr_; }
+
+    // 解引用
+    reference operator*() const { return *ptr_; }
+    pointer operator->() const { return ptr_; }
+    reference operator[](const difference_type n) const { return ptr_[n]; }
+
+    // 自增自减
+    ContiguousIterator &operator++() {
+        ++ptr_;
+        return *this;
+    }
+
+    ContiguousIterator operator++(int) {
+        ContiguousIterator old = *this;
+        ++ptr_;
+        return old;
+    }
+
+    ContiguousIterator &operator--() {
+        --ptr_;
+        return *this;
+    }
+
+    ContiguousIterator operator--(int) {
+        ContiguousIterator old = *this;
+        --ptr_;
+        return old;
+    }
+
+    // 算术
+    ContiguousIterator &operator+=(const difference_type n) {
+        ptr_ += n;
+        return *this;
+    }
+
+    ContiguousIterator &operator-=(const difference_type n) {
+        ptr_ -= n;
+        return *this;
+    }
+
+    friend ContiguousIterator operator+(ContiguousIterator it, const difference_type n) { return it += n; }
+    friend ContiguousIterator operator+(const difference_type n, ContiguousIterator it) { return it += n; }
+    friend ContiguousIterator operator-(ContiguousIterator it, const difference_type n) { return it -= n; }
+
+    template<typename U>
+    difference_type operator-(const ContiguousIterator<U> &other) const { return ptr_ - other.base(); }
+
+    // 比较（const 与非 const 之间也可以）
+    template<typename U>
+    bool operator==(const ContiguousIterator<U> &other) const { return ptr_ == other.base(); }
+
+    template<typename U>
+    std::strong_ordering operator<=>(const ContiguousIterator<U> &other) const {
+        return ptr_ <=> other.base();
+    }
+
+private:
+    T *ptr_ = nullptr;
+};
@@ -0,0 +1,497 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// ======================================================
+// 开放寻址的扁平哈希表（Swiss table 风格）：FlatHashMap<K, V> / FlatHashSet<K>
+// std::unordered_map 每个元素一个堆上的节点，查找 = 算桶 + 顺着链表跳指针，几乎每次都是一次缓存缺失。
+// 这里所有元素直接放在一个连续的槽位数组里，另有一个控制字节数组，每个槽位一个字节：
+//   0x80        空槽
+//   0x00~0x7F   有元素，值是哈希值的低 7 位（h2）
+// 哈希值的其余位（h1）决定起始位置。查找时一次加载 16 个控制字节（一组），用 SSE2 一条比较指令
+// 找出所有 h2 相同的槽位，只对这些候选比较键；组里出现空槽就说明键不存在。
+// 控制字节数组末尾多复制 15 个字节（镜像开头），从任何位置加载一组都不用处理回绕。
+//
+// 删除不留墓碑（tombstone）：用线性探测 + 向后移位删除。不变式是"元素的起始位置到它实际位置之间没有空槽"，
+// 删除后把后面同一簇里可以前移的元素依次挪进空位，表里永远只有"空"和"满"两种槽位，
+// 大量删除之后查找也不会变慢，也不需要为清理墓碑而重建。
+//
+// 异构查找：哈希和相等比较都是 transparent 的（默认的 FlatHash<std::string> 与 std::equal_to<>），
+// 可以直接用 std::string_view / const char* 查 std::string 键，不用构造临时字符串。
+// 注意：插入或删除都可能移动其他元素，迭代器和元素引用随之失效（与 std::unordered_map 不同）。
+// ======================================================
+
+// 默认哈希：整数等类型在 std::hash 之后再混合一次（std::hash<int> 是恒等函数，线性探测会聚集成一大簇）；
+// 字符串类支持 transparent 查找
+template<typename T>
+struct FlatHash {
+    size_t operator()(const T &value) const {
+        uint64_t h = std::hash<T>{}(value);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return h;
+    }
+};
+
+template<>
+struct FlatHash<std::string> {
+    using is_transparent = void;
+
+    size_t operator()(const std::string_view s) const { return std::hash<std::string_view>{}(s); }
+};
+
+namespace flat_detail {
+
+constexpr uint8_t kEmpty = 0x80;
+constexpr size_t kGroup = 16;
+
+// 一组 16 个控制字节：match 返回等于 h2 的位掩码，empty 返回空槽的位掩码
+struct Group {
+#if defined(__SSE2__)
+    __m128i ctrl;
+
+    explicit Group(const uint8_t *p) : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p))) {
+    }
+
+    [[nodiscard]] uint32_t match(const uint8_t h2) const {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(h2)), ctrl)));
+    }
+
+    // 空槽 0x80 是唯一最高位为 1 的控制字节
+    [[nodiscard]] uint32_t empty() const { return static_cast<uint32_t>(_mm_movemask_epi8(ctrl)); }
+#else
+    uint8_t ctrl[kGroup];
+
+    explicit Group(const uint8_t *p) { std::memcpy(ctrl, p, kGroup); }
+
+    [[nodiscard]] uint32_t match(const uint8_t h2) const {
+        uint32_t m = 0;
+        for (size_t i = 0; i < kGroup; ++i)
+            m |= static_cast<uint32_t>(ctrl[i] == h2) << i;
+        return m;
+    }
+
+    [[nodiscard]] uint32_t empty() const { return match(kEmpty); }
+#endif
+};
+
+// ======================================================
+// 表的主体：Slot 是槽位里存的类型，KeyOf 从槽位取出键
+// ======================================================
+template<typename Slot, typename KeyOf, typename Hash, typename Eq>
+class Table {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    Table() = default;
+
+    Table(const Table &other) : hash_(other.hash_), eq_(other.eq_) {
+        reserve(other.size_);
+        for (size_t i = 0; i < other.cap_; ++i)
+            if (other.full(i))
+                insert_new(other.hash_of(i), other.slots_[i]);
+    }
+
+    Table(Table &&other) noexcept : hash_(other.hash_), eq_(other.eq_) {
+        swap(other);
+    }
+
+    Table &operator=(const Table &other) {
+        if (this == &other)
+            return *this;
+        Table copy(other);
+        swap(copy);
+        return *this;
+    }
+
+    Table &operator=(Table &&other) noexcept {
+        Table moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    ~Table() {
+        destroy_all();
+        release(ctrl_, slots_, cap_);
+    }
+
+    void swap(Table &other) noexcept {
+        std::swap(ctrl_, other.ctrl_);
+        std::swap(slots_, other.slots_);
+        std::swap(cap_, other.cap_);
+        std::swap(size_, other.size_);
+        std::swap(hash_, other.hash_);
+        std::swap(eq_, other.eq_);
+    }
+
+    [[nodiscard]] size_t size() const { return size_; }
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+    [[nodiscard]] size_t capacity() const { return cap_; }
+    [[nodiscard]] bool full(const size_t i) const { return ctrl_[i] != kEmpty; }
+    Slot &slot(const size_t i) { return slots_[i]; }
+    const Slot &slot(const size_t i) const { return slots_[i]; }
+
+    // 查找：返回槽位下标，不存在返回 npos
+    template<typename K>
+    size_t find(const K &key) const {
+        return size_ == 0 ? npos : find(key, hash_(key));
+    }
+
+    // 查找 key，不存在时用 args 构造一个新元素；返回 {下标, 是否新插入}
+    template<typename K, typename... Args>
+    std::pair<size_t, bool> find_or_emplace(const K &key, Args &&... args) {
+        const size_t h = hash_(key);
+        if (size_ > 0) {
+            const size_t found = find(key, h);
+            if (found != npos)
+                return {found, false};
+        }
+        if ((size_ + 1) * 8 > cap_ * 7)
+            rehash(cap_ == 0 ? kGroup : cap_ * 2);
+        return {insert_new(h, std::forward<Args>(args)...), true};
+    }
+
+    // 删除：向后移位，不留墓碑
+    template<typename K>
+    size_t erase(const K &key) {
+        const size_t i = find(key);
+        if (i == npos)
+            return 0;
+        erase_at(i);
+        return 1;
+    }
+
+    void erase_at(size_t hole) {
+        const size_t mask = cap_ - 1;
+        slots_[hole].~Slot();
+        for (size_t j = (hole + 1) & mask; full(j); j = (j + 1) & mask) {
+            // j 处的元素能挪到 hole：hole 在它的起始位置和 j 之间（按环形距离）
+            const size_t home = home_of(hash_of(j));
+            if (((j - home) & mask) >= ((j - hole) & mask)) {
+                ::new(static_cast<void *>(&slots_[hole])) Slot(std::move(slots_[j]));
+                slots_[j].~Slot();
+                set_ctrl(hole, ctrl_[j]);
+                hole = j;
+            }
+        }
+        set_ctrl(hole, kEmpty);
+        --size_;
+    }
+
+    void clear() {
+        destroy_all();
+        if (cap_ > 0)
+            std::memset(ctrl_, kEmpty, cap_ + kGroup - 1);
+        size_ = 0;
+    }
+
+    // 保证能放下 n 个元素而不用再扩容
+    void reserve(const size_t n) {
+        size_t cap = cap_ == 0 ? kGroup : cap_;
+        while (n * 8 > cap * 7)
+            cap *= 2;
+        if (cap != cap_)
+            rehash(cap);
+    }
+
+    // 迭代用：从 i 开始的第一个有元素的槽位，没有则返回 capacity()
+    [[nodiscard]] size_t next_full(size_t i) const {
+        while (i < cap_ && !full(i))
+            ++i;
+        return i;
+    }
+
+private:
+    uint8_t *ctrl_ = nullptr; // cap_ + 15 个字节，末尾 15 个是开头的镜像
+    Slot *slots_ = nullptr;
+    size_t cap_ = 0; // 2 的幂，至少 16
+    size_t size_ = 0;
+    [[no_unique_address]] Hash hash_;
+    [[no_unique_address]] Eq eq_;
+
+    [[nodiscard]] size_t hash_of(const size_t i) const { return hash_(KeyOf()(slots_[i])); }
+
+    // h1 = h >> 7 决定起始位置，h2 = 低 7 位存进控制字节
+    [[nodiscard]] size_t home_of(const size_t h) const { return (h >> 7) & (cap_ - 1); }
+
+    // 从起始位置所在的组开始，一组一组往后看；组里有空槽就可以停了
+    template<typename K>
+    size_t find(const K &key, const size_t h) const {
+        const auto h2 = static_cast<uint8_t>(h & 0x7F);
+        const size_t mask = cap_ - 1;
+        size_t pos = home_of(h);
+        while (true) {
+            const Group g(ctrl_ + pos);
+            for (uint32_t m = g.match(h2); m != 0; m &= m - 1) {
+                const size_t i = (pos + std::countr_zero(m)) & mask;
+                if (eq_(KeyOf()(slots_[i]), key))
+                    return i;
+            }
+            if (g.empty() != 0)
+                return npos;
+            pos = (pos + kGroup) & mask;
+        }
+    }
+
+    void set_ctrl(const size_t i, const uint8_t v) {
+        ctrl_[i] = v;
+        if (i < kGroup - 1)
+            ctrl_[cap_ + i] = v;
+    }
+
+    // 已知键不存在、容量足够：从起始位置往后第一个空槽放进去（线性探测，一次看 16 个）
+    template<typename... Args>
+    size_t insert_new(const size_t h, Args &&... args) {
+        const size_t mask = cap_ - 1;
+        size_t pos = home_of(h);
+        uint32_t e;
+        while ((e = Group(ctrl_ + pos).empty()) == 0)
+            pos = (pos + kGroup) & mask;
+        const size_t i = (pos + std::countr_zero(e)) & mask;
+        ::new(static_cast<void *>(&slots_[i])) Slot(std::forward<Args>(args)...);
+        set_ctrl(i, static_cast<uint8_t>(h & 0x7F));
+        ++size_;
+        return i;
+    }
+
+    void rehash(const size_t newCap) {
+        uint8_t *oldCtrl = ctrl_;
+        Slot *oldSlots = slots_;
+        const size_t oldCap = cap_;
+
+        ctrl_ = static_cast<uint8_t *>(::operator new(newCap + kGroup - 1));
+        try {
+            slots_ = static_cast<Slot *>(::operator new(newCap * sizeof(Slot), std::align_val_t{alignof(Slot)}));
+        } catch (...) {
+            ::operator delete(ctrl_);
+            ctrl_ = oldCtrl;
+            throw;
+        }
+        std::memset(ctrl_, kEmpty, newCap + kGroup - 1);
+        cap_ = newCap;
+        size_ = 0;
+
+        // 元素移到新表：新表里键都不相同，不用比较，直接找空槽
+        for (size_t i = 0; i < oldCap; ++i) {
+            if (oldCtrl[i] == kEmpty)
+                continue;
+            insert_new(hash_(KeyOf()(oldSlots[i])), std::move(oldSlots[i]));
+            oldSlots[i].~Slot();
+        }
+        release(oldCtrl, oldSlots, oldCap);
+    }
+
+    void destroy_all() {
+        if constexpr (!std::is_trivially_destructible_v<Slot>) {
+            for (size_t i = 0; i < cap_; ++i)
+                if (full(i))
+                    slots_[i].~Slot();
+        }
+    }
+
+    static void release(uint8_t *ctrl, Slot *slots, const size_t cap) {
+        if (cap == 0)
+            return;
+        ::operator delete(ctrl);
+        ::operator delete(slots, std::align_val_t{alignof(Slot)});
+    }
+};
+
+// 单向迭代器：跳过空槽
+template<typename Table, typename Ref>
+class Iterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::remove_cvref_t<Ref>;
+    using difference_type = std::ptrdiff_t;
+    using reference = Ref;
+    using pointer = std::remove_reference_t<Ref> *;
+
+    Iterator() = default;
+
+    Iterator(Table *table, const size_t i) : table_(table), i_(i) {
+    }
+
+    reference operator*() const { return reinterpret_cast<reference>(table_->slot(i_)); }
+    pointer operator->() const { return &**this; }
+
+    Iterator &operator++() {
+        i_ = table_->next_full(i_ + 1);
+        return *this;
+    }
+
+    Iterator operator++(int) {
+        Iterator old = *this;
+        ++*this;
+        return old;
+    }
+
+    bool operator==(const Iterator &other) const { return i_ == other.i_; }
+
+    [[nodiscard]] size_t index() const { return i_; }
+
+private:
+    Table *table_ = nullptr;
+    size_t i_ = 0;
+};
+
+struct PairKey {
+    template<typename P>
+    const auto &operator()(const P &p) const { return p.first; }
+};
+
+struct SelfKey {
+    template<typename K>
+    const K &operator()(const K &k) const { return k; }
+};
+
+} // namespace flat_detail
+
+// ======================================================
+// FlatHashMap<K, V>
+// 槽位里存 std::pair<K, V>，对外按 std::pair<const K, V> 访问（两者布局相同），
+// 这样删除和扩容时可以移动键而不是拷贝
+// ======================================================
+template<typename K, typename V, typename Hash = FlatHash<K>, typename Eq = std::equal_to<> >
+class FlatHashMap {
+    using Table = flat_detail::Table<std::pair<K, V>, flat_detail::PairKey, Hash, Eq>;
+
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<const K, V>;
+    using iterator = flat_detail::Iterator<Table, value_type &>;
+    using const_iterator = flat_detail::Iterator<const Table, const value_type &>;
+
+    [[nodiscard]] size_t size() const { return table_.size(); }
+    [[nodiscard]] bool empty() const { return table_.empty(); }
+    [[nodiscard]] size_t capacity() const { return table_.capacity(); }
+    void reserve(const size_t n) { table_.reserve(n); }
+    void clear() { table_.clear(); }
+
+    // 键类型可以是任何能与 K 比较、能被 Hash 计算的类型（例如用 string_view 查 string 键）
+    template<typename Q>
+    iterator find(const Q &key) { return make_iterator(table_.find(key)); }
+
+    template<typename Q>
+    const_iterator find(const Q &key) const { return make_iterator(table_.find(key)); }
+
+    template<typename Q>
+    bool contains(const Q &key) const { return table_.find(key) != Table::npos; }
+
+    template<typename Q>
+    size_t count(const Q &key) const { return contains(key) ? 1 : 0; }
+
+    template<typename Q>
+    V &at(const Q &key) {
+        const size_t i = table_.find(key);
+        if (i == Table::npos)
+            throw std::out_of_range("FlatHashMap::at: key not found");
+        return table_.slot(i).second;
+    }
+
+    // 键不存在时用 args 构造值
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(const K &key, Args &&... args) {
+        const auto [i, inserted] = table_.find_or_emplace(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                                          std::forward_as_tuple(std::forward<Args>(args)...));
+        return {iterator(&table_, i), inserted};
+    }
+
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(K &&key, Args &&... args) {
+        const auto [i, inserted] = table_.find_or_emplace(key, std::piecewise_construct,
+                                                          std::forward_as_tuple(std::move(key)),
+                                                          std::forward_as_tuple(std::forward<Args>(args)...));
+        return {iterator(&table_, i), inserted};
+    }
+
+    std::pair<iterator, bool> insert(const std::pair<K, V> &kv) { return try_emplace(kv.first, kv.second); }
+
+    V &operator[](const K &key) { return try_emplace(key).first->second; }
+    V &operator[](K &&key) { return try_emplace(std::move(key)).first->second; }
+
+    template<typename Q>
+    size_t erase(const Q &key) { return table_.erase(key); }
+
+    iterator begin() { return iterator(&table_, table_.next_full(0)); }
+    iterator end() { return iterator(&table_, table_.capacity()); }
+    const_iterator begin() const { return const_iterator(&table_, table_.next_full(0)); }
+    const_iterator end() const { return const_iterator(&table_, table_.capacity()); }
+
+private:
+    Table table_;
+
+    iterator make_iterator(const size_t i) { return i == Table::npos ? end() : iterator(&table_, i); }
+
+    const_iterator make_iterator(const size_t i) const {
+        return i == Table::npos ? end() : const_iterator(&table_, i);
+    }
+};
+
+// ======================================================
+// FlatHashSet<K>
+// ======================================================
+template<typename K, typename Hash = FlatHash<K>, typename Eq = std::equal_to<> >
+class FlatHashSet {
+    using Table = flat_detail::Table<K, flat_detail::SelfKey, Hash, Eq>;
+
+public:
+    using key_type = K;
+    using value_type = K;
+    using iterator = flat_detail::Iterator<const Table, const K &>;
+    using const_iterator = iterator;
+
+    [[nodiscard]] size_t size() const { return table_.size(); }
+    [[nodiscard]] bool empty() const { return table_.empty(); }
+    [[nodiscard]] size_t capacity() const { return table_.capacity(); }
+    void reserve(const size_t n) { table_.reserve(n); }
+    void clear() { table_.clear(); }
+
+    std::pair<iterator, bool> insert(const K &key) {
+        const auto [i, inserted] = table_.find_or_emplace(key, key);
+        return {iterator(&table_, i), inserted};
+    }
+
+    std::pair<iterator, bool> insert(K &&key) {
+        const auto [i, inserted] = table_.find_or_emplace(key, std::move(key));
+        return {iterator(&table_, i), inserted};
+    }
+
+    template<typename Q>
+    iterator find(const Q &key) const {
+        const size_t i = table_.find(key);
+        return i == Table::npos ? end() : iterator(&table_, i);
+    }
+
+    template<typename Q>
+    bool contains(const Q &key) const { return table_.find(key) != Table::npos; }
+
+    template<typename Q>
+    size_t count(const Q &key) const { return contains(key) ? 1 : 0; }
+
+    template<typename Q>
+    size_t erase(const Q &key) { return table_.erase(key); }
+
+    iterator begin() const { return iterator(&table_, table_.next_full(0)); }
+    iterator end() const { return iterator(&table_, table_.capacity()); }
+
+private:
+    Table table_;
+};
@@ -0,0 +1,341 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ======================================================
+// 有序扁平映射 FlatMap<K, V>：std::map 的只读为主替代品（C++23 std::flat_map 的做法）
+// std::map 是红黑树，每个元素一个节点、一次分配，查找时沿着树每下一层就是一次指针跳转（通常是缓存缺失），
+// 顺序遍历也要在分散的节点之间来回跳。FlatMap 把键和值分别存在两个按键排序的连续数组里：
+//   - 查找：在键数组上二分，只碰键，不把值带进缓存
+//   - 顺序遍历：两个数组从头扫到尾，硬件预取完全生效
+//   - 代价：单个插入 / 删除要搬动后面所有元素，O(n)
+// 所以适合"一次建好、大量查询"：用一批数据整体构造（排序 + 去重，O(n log n)），
+// 或者 insert(first, last) 批量插入（新数据排序后与已有数据归并）。
+// 迭代器解引用得到 std::pair<const K &, V &> 代理（键值不在一起存放，给不出真正的 pair 引用），
+// 支持结构化绑定：for (auto [k, v] : m)。
+// FlatMultiMap 允许重复键（对应 std::multimap），相等的键按插入顺序排列。
+// 注意：插入和删除会使迭代器和引用失效。
+// ======================================================
+template<bool Const, typename K, typename V>
+class FlatMapIterator {
+    using Mapped = std::conditional_t<Const, const V, V>;
+
+public:
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::pair<K, V>;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::pair<const K &, Mapped &>;
+
+    // -> 需要一个指针，代理是临时对象，所以把它包一层
+    struct pointer {
+        reference ref;
+        const reference *operator->() const { return &ref; }
+    };
+
+    FlatMapIterator() = default;
+
+    FlatMapIterator(const K *key, Mapped *value) : key_(key), value_(value) {
+    }
+
+    // iterator -> const_iterator
+    template<bool C> requires (Const && !C)
+    FlatMapIterator(const FlatMapIterator<C, K, V> &other) : key_(other.key_), value_(other.value_) {
+    }
+
+    reference operator*() const { return {*key_, *value_}; }
+    pointer operator->() const { return {**this}; }
+    reference operator[](const difference_type n) const { return {key_[n], value_[n]}; }
+
+    FlatMapIterator &operator++() {
+        ++key_;
+        ++value_;
+        return *this;
+    }
+
+    FlatMapIterator operator++(int) {
+        FlatMapIterator old = *this;
+        ++*this;
+        return old;
+    }
+
+    FlatMapIterator &operator--() {
+        --key_;
+        --value_;
+        return *this;
+    }
+
+    FlatMapIterator operator--(int) {
+        FlatMapIterator old = *this;
+        --*this;
+        return old;
+    }
+
+    FlatMapIterator &operator+=(const difference_type n) {
+        key_ += n;
+        value_ += n;
+        return *this;
+    }
+
+    FlatMapIterator &operator-=(const difference_type n) { return *this += -n; }
+
+    friend FlatMapIterator operator+(FlatMapIterator it, const difference_type n) { return it += n; }
+    friend FlatMapIterator operator+(const difference_type n, FlatMapIterator it) { return it += n; }
+    friend FlatMapIterator operator-(FlatMapIterator it, const difference_type n) { return it -= n; }
+
+    difference_type operator-(const FlatMapIterator &other) const { return key_ - other.key_; }
+
+    bool operator==(const FlatMapIterator &other) const { return key_ == other.key_; }
+    std::strong_ordering operator<=>(const FlatMapIterator &other) const { return key_ <=> other.key_; }
+
+    [[nodiscard]] const K *key_ptr() const { return key_; }
+
+private:
+    friend class FlatMapIterator<true, K, V>;
+    const K *key_ = nullptr;
+    Mapped *value_ = nullptr;
+};
+
+template<typename K, typename V, typename Compare, bool Multi>
+class BasicFlatMap {
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<K, V>;
+    using iterator = FlatMapIterator<false, K, V>;
+    using const_iterator = FlatMapIterator<true, K, V>;
+
+    BasicFlatMap() = default;
+
+    // 批量构造：按键稳定排序，FlatMap 再去重（键相同时保留先出现的那个），O(n log n)
+    explicit BasicFlatMap(std::vector<value_type> items) {
+        sort_items(items);
+        assign_sorted(items);
+    }
+
+    // ----------------------------
+    // 查找：键数组上二分；Compare 是 transparent 的，可以用其他类型的键查
+    // ----------------------------
+    template<typename Q>
+    iterator lower_bound(const Q &key) { return at_index(lower_index(key)); }
+
+    template<typename Q>
+    const_iterator lower_bound(const Q &key) const { return at_index(lower_index(key)); }
+
+    template<typename Q>
+    iterator upper_bound(const Q &key) { return at_index(upper_index(key)); }
+
+    template<typename Q>
+    const_iterator upper_bound(const Q &key) const { return at_index(upper_index(key)); }
+
+    template<typename Q>
+    std::pair<iterator, iterator> equal_range(const Q &key) { return {lower_bound(key), upper_bound(key)}; }
+
+    template<typename Q>
+    std::pair<const_iterator, const_iterator> equal_range(const Q &key) const {
+        return {lower_bound(key), upper_bound(key)};
+    }
+
+    // 重复键时返回第一个
+    template<typename Q>
+    iterator find(const Q &key) {
+        const size_t i = find_index(key);
+        return i == size() ? end() : at_index(i);
+    }
+
+    template<typename Q>
+    const_iterator find(const Q &key) const {
+        const size_t i = find_index(key);
+        return i == size() ? end() : at_index(i);
+    }
+
+    template<typename Q>
+    bool contains(const Q &key) const { return find_index(key) != size(); }
+
+    template<typename Q>
+    size_t count(const Q &key) const {
+        if constexpr (Multi)
+            return upper_index(key) - lower_index(key);
+        else
+            return contains(key) ? 1 : 0;
+    }
+
+    template<typename Q>
+    V &at(const Q &key) requires (!Multi) {
+        const size_t i = find_index(key);
+        if (i == size())
+            throw std::out_of_range("FlatMap::at: key not found");
+        return values_[i];
+    }
+
+    // ----------------------------
+    // 单个插入 / 删除：O(n)，搬动后面的元素
+    // FlatMap 键已存在时什么都不做；FlatMultiMap 总是插入，排在相等的键后面
+    // ----------------------------
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(const K &key, Args &&... args) requires (!Multi) {
+        const size_t i = lower_index(key);
+        if (i < size() && !comp_(key, keys_[i]))
+            return {at_index(i), false};
+        return {insert_at(i, key, std::forward<Args>(args)...), true};
+    }
+
+    std::pair<iterator, bool> insert(const value_type &kv) requires (!Multi) {
+        return try_emplace(kv.first, kv.second);
+    }
+
+    V &operator[](const K &key) requires (!Multi) { return try_emplace(key).first->second; }
+
+    template<typename... Args>
+    iterator emplace(const K &key, Args &&... args) requires Multi {
+        return insert_at(upper_index(key), key, std::forward<Args>(args)...);
+    }
+
+    iterator insert(const value_type &kv) requires Multi { return emplace(kv.first, kv.second); }
+
+    // 按键删掉所有相等的元素，返回个数
+    template<typename Q>
+    size_t erase(const Q &key) requires (!std::is_convertible_v<const Q &, const_iterator>) {
+        const size_t first = lower_index(key), last = upper_index(key);
+        keys_.erase(keys_.begin() + first, keys_.begin() + last);
+        values_.erase(values_.begin() + first, values_.begin() + last);
+        return last - first;
+    }
+
+    // 按位置删一个，返回它后面的位置
+    iterator erase(const const_iterator pos) {
+        const size_t i = pos.key_ptr() - keys_.data();
+        keys_.erase(keys_.begin() + i);
+        values_.erase(values_.begin() + i);
+        return at_index(i);
+    }
+
+    iterator erase(const iterator pos) { return erase(const_iterator(pos)); }
+
+    // 批量插入：新数据排序（FlatMap 再去重）后与已有数据归并，O(n + m log m)；
+    // 键相同时已有的元素排在前面，FlatMap 保留已有的值
+    template<std::input_iterator It>
+    void insert(It first, It last) {
+        std::vector<value_type> items(first, last);
+        if (items.empty())
+            return;
+        sort_items(items);
+
+        std::vector<K> keys;
+        std::vector<V> values;
+        keys.reserve(size() + items.size());
+        values.reserve(size() + items.size());
+        size_t i = 0, j = 0;
+        while (i < size() || j < items.size()) {
+            if (j == items.size() || (i < size() && !comp_(items[j].first, keys_[i]))) {
+                if (!Multi && j < items.size() && !comp_(keys_[i], items[j].first))
+                    ++j; // 键已存在
+                keys.push_back(std::move(keys_[i]));
+                values.push_back(std::move(values_[i]));
+                ++i;
+            } else {
+                keys.push_back(std::move(items[j].first));
+                values.push_back(std::move(items[j].second));
+                ++j;
+            }
+        }
+        keys_.swap(keys);
+        values_.swap(values);
+    }
+
+    void reserve(const size_t n) {
+        keys_.reserve(n);
+        values_.reserve(n);
+    }
+
+    void clear() {
+        keys_.clear();
+        values_.clear();
+    }
+
+    [[nodiscard]] size_t size() const { return keys_.size(); }
+    [[nodiscard]] bool empty() const { return keys_.empty(); }
+
+    // 两列各自连续，可以直接交给 simd 内核等
+    std::span<const K> keys() const { return keys_; }
+    std::span<V> values() { return values_; }
+    std::span<const V> values() const { return values_; }
+
+    iterator begin() { return at_index(0); }
+    iterator end() { return at_index(size()); }
+    const_iterator begin() const { return at_index(0); }
+    const_iterator end() const { return at_index(size()); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+private:
+    std::vector<K> keys_;
+    std::vector<V> values_;
+    [[no_unique_address]] Compare comp_;
+
+    iterator at_index(const size_t i) { return iterator(keys_.data() + i, values_.data() + i); }
+    const_iterator at_index(const size_t i) const { return const_iterator(keys_.data() + i, values_.data() + i); }
+
+    template<typename Q>
+    size_t lower_index(const Q &key) const {
+        return std::lower_bound(keys_.begin(), keys_.end(), key, comp_) - keys_.begin();
+    }
+
+    template<typename Q>
+    size_t upper_index(const Q &key) const {
+        return std::upper_bound(keys_.begin(), keys_.end(), key, comp_) - keys_.begin();
+    }
+
+    // 找到返回下标，找不到返回 size()
+    template<typename Q>
+    size_t find_index(const Q &key) const {
+        const size_t i = lower_index(key);
+        return i < size() && !comp_(key, keys_[i]) ? i : size();
+    }
+
+    template<typename... Args>
+    iterator insert_at(const size_t i, const K &key, Args &&... args) {
+        keys_.insert(keys_.begin() + i, key);
+        try {
+            values_.emplace(values_.begin() + i, std::forward<Args>(args)...);
+        } catch (...) {
+            keys_.erase(keys_.begin() + i);
+            throw;
+        }
+        return at_index(i);
+    }
+
+    void sort_items(std::vector<value_type> &items) const {
+        const auto less = [this](const value_type &a, const value_type &b) { return comp_(a.first, b.first); };
+        std::stable_sort(items.begin(), items.end(), less);
+        if constexpr (!Multi) {
+            const auto same = [this](const value_type &a, const value_type &b) { return !comp_(a.first, b.first); };
+            items.erase(std::unique(items.begin(), items.end(), same), items.end());
+        }
+    }
+
+    void assign_sorted(std::vector<value_type> &items) {
+        keys_.reserve(items.size());
+        values_.reserve(items.size());
+        for (value_type &kv : items) {
+            keys_.push_back(std::move(kv.first));
+            values_.push_back(std::move(kv.second));
+        }
+    }
+};
+
+template<typename K, typename V, typename Compare = std::less<> >
+using FlatMap = BasicFlatMap<K, V, Compare, false>;
+
+// 允许重复键，相等的键按插入顺序排列（对应 std::multimap）
+template<typename K, typename V, typename Compare = std::less<> >
+using FlatMultiMap = BasicFlatMap<K, V, Compare, true>;
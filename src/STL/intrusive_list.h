@@ -0,0 +1,430 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../OOD/object_pool.h"
+
+// ======================================================
+// 侵入式双向链表 IntrusiveList<T, Tag>
+// std::list<T> 的每个节点是 {prev, next, T}，每次插入都要 new 一个节点；而 LRU、定时器链这类场景里
+// 元素本来就存在别处（哈希表里、连接对象里），链表只是把它们串起来。
+// 侵入式链表把 prev/next（钩子 ListHook）直接放在元素里：
+//   - 插入、删除不分配任何内存，元素的生命周期由使用者管理
+//   - 拿到元素就能 O(1) 把它从链表中间摘下来（erase(x)），std::list 需要先保存迭代器
+//   - splice 在两个链表之间搬元素，只改指针
+// 一个元素可以同时挂在几条链表上：每条链表用一个 Tag 区分，元素从对应的 ListHook<Tag> 继承，例如
+//   struct Conn : ListHook<LruTag>, ListHook<TimerTag> { ... };
+//   IntrusiveList<Conn, LruTag> lru;  IntrusiveList<Conn, TimerTag> timers;
+// 链表是带哨兵的环：空链表的哨兵指向自己，插入删除没有边界判断。
+// 注意：链表不拥有元素；元素析构前必须先从链表上摘下来。需要链表自己管理节点时用下面的 PooledList。
+// ======================================================
+template<typename Tag = void>
+struct ListHook {
+    ListHook *prev = nullptr;
+    ListHook *next = nullptr;
+
+    ListHook() = default;
+
+    // 拷贝元素时不拷贝钩子：副本不在任何链表上
+    ListHook(const ListHook &) {
+    }
+
+    ListHook &operator=(const ListHook &) { return *this; }
+
+    [[nodiscard]] bool is_linked() const { return next != nullptr; }
+};
+
+template<typename T, typename Tag = void>
+class IntrusiveList {
+    using Hook = ListHook<Tag>;
+    static_assert(std::is_base_of_v<Hook, T>, "T must derive from ListHook<Tag>");
+
+public:
+    template<bool Const>
+    class Iter {
+        using Ref = std::conditional_t<Const, const T &, T &>;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T *, T *>;
+        using reference = Ref;
+
+        Iter() = default;
+
+        explicit Iter(Hook *hook) : hook_(hook) {
+        }
+
+        // iterator -> const_iterator
+        template<bool C> requires (Const && !C)
+        Iter(const Iter<C> &other) : hook_(other.hook_) {
+        }
+
+        reference operator*() const { return static_cast<Ref>(*hook_); }
+        pointer operator->() const { return &**this; }
+
+        Iter &operator++() {
+            hook_ = hook_->next;
+            return *this;
+        }
+
+        Iter operator++(int) {
+            Iter old = *this;
+            hook_ = hook_->next;
+            return old;
+        }
+
+        Iter &operator--() {
+            hook_ = hook_->prev;
+            return *this;
+        }
+
+        Iter operator--(int) {
+            Iter old = *this;
+            hook_ = hook_->prev;
+            return old;
+        }
+
+        bool operator==(const Iter &other) const { return hook_ == other.hook_; }
+
+    private:
+        friend class IntrusiveList;
+        friend class Iter<true>;
+        Hook *hook_ = nullptr;
+    };
+
+    using value_type = T;
+    using iterator = Iter<false>;
+    using const_iterator = Iter<true>;
+
+    IntrusiveList() {
+        head_.prev = head_.next = &head_;
+    }
+
+    IntrusiveList(const IntrusiveList &) = delete;
+    IntrusiveList &operator=(const IntrusiveList &) = delete;
+
+    // 移动：元素留在原地，只是换一个哨兵
+    IntrusiveList(IntrusiveList &&other) noexcept : IntrusiveList() {
+        splice(end(), other);
+    }
+
+    IntrusiveList &operator=(IntrusiveList &&other) noexcept {
+        if (this != &other) {
+            clear();
+            splice(end(), other);
+        }
+        return *this;
+    }
+
+    ~IntrusiveList() { clear(); }
+
+    // ----------------------------
+    // 插入 / 删除：O(1)，不分配内存
+    // ----------------------------
+    void push_front(T &x) { link_before(head_.next, x); }
+    void push_back(T &x) { link_before(&head_, x); }
+
+    // 插在 pos 之前，返回指向 x 的迭代器
+    iterator insert(const const_iterator pos, T &x) {
+        link_before(pos.hook_, x);
+        return iterator_to(x);
+    }
+
+    void pop_front() {
+        if (empty())
+            throw std::out_of_range("list empty");
+        unlink(head_.next);
+    }
+
+    void pop_back() {
+        if (empty())
+            throw std::out_of_range("list empty");
+        unlink(head_.prev);
+    }
+
+    // 从链表中间摘下 x（x 必须在这条链表上），返回它后面的位置
+    iterator erase(T &x) {
+        Hook *next = as_hook(x)->next;
+        unlink(as_hook(x));
+        return iterator(next);
+    }
+
+    iterator erase(const const_iterator pos) { return erase(const_cast<T &>(*pos)); }
+
+    // 摘下所有元素（元素本身不动，钩子清空后可以挂到别的链表上）
+    void clear() {
+        Hook *h = head_.next;
+        while (h != &head_) {
+            Hook *next = h->next;
+            h->prev = h->next = nullptr;
+            h = next;
+        }
+        head_.prev = head_.next = &head_;
+        size_ = 0;
+    }
+
+    // ----------------------------
+    // splice：把 other 的全部元素 / 其中一个元素 x 搬到 pos 之前，O(1)
+    // other 可以就是 *this（例如 LRU 把命中的元素挪到最前：lru.splice(lru.begin(), lru, x)）
+    // ----------------------------
+    void splice(const const_iterator pos, IntrusiveList &other) {
+        if (&other == this || other.empty())
+            return;
+        Hook *first = other.head_.next, *last = other.head_.prev, *at = pos.hook_;
+        other.head_.prev = other.head_.next = &other.head_;
+        first->prev = at->prev;
+        at->prev->next = first;
+        last->next = at;
+        at->prev = last;
+        size_ += other.size_;
+        other.size_ = 0;
+    }
+
+    void splice(const const_iterator pos, IntrusiveList &other, T &x) {
+        Hook *h = as_hook(x);
+        if (h == pos.hook_ || h->next == pos.hook_)
+            return; // 已经在 pos 之前
+        other.unlink(h);
+        link_before(pos.hook_, x);
+    }
+
+    // ----------------------------
+    // 访问
+    // ----------------------------
+    T &front() {
+        if (empty())
+            throw std::runtime_error("list empty");
+        return static_cast<T &>(*head_.next);
+    }
+
+    T &back() {
+        if (empty())
+            throw std::runtime_error("list empty");
+        return static_cast<T &>(*head_.prev);
+    }
+
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+    [[nodiscard]] size_t size() const { return size_; }
+
+    // 由元素得到迭代器，O(1)
+    static iterator iterator_to(T &x) { return iterator(as_hook(x)); }
+
+    iterator begin() { return iterator(head_.next); }
+    iterator end() { return iterator(&head_); }
+    const_iterator begin() const { return const_iterator(head_.next); }
+    const_iterator end() const { return const_iterator(const_cast<Hook *>(&head_)); }
+
+private:
+    Hook head_; // 哨兵：next 是第一个元素，prev 是最后一个
+    size_t size_ = 0;
+
+    static Hook *as_hook(T &x) { return static_cast<Hook *>(&x); }
+
+    void link_before(Hook *at, T &x) {
+        Hook *h = as_hook(x);
+        h->prev = at->prev;
+        h->next = at;
+        at->prev->next = h;
+        at->prev = h;
+        ++size_;
+    }
+
+    void unlink(Hook *h) {
+        h->prev->next = h->next;
+        h->next->prev = h->prev;
+        h->prev = h->next = nullptr;
+        --size_;
+    }
+};
+
+// ======================================================
+// 带节点池的链表 PooledList<T>：接口同 std::list，节点 {钩子, T} 从 ObjectPool（单线程的自由链表池）申请，
+// 删掉的节点回到池里，下次插入直接复用，
+// 稳定的插入删除循环里不再调用 new / delete。
+// 几条链表可以共用一个池（池必须比链表活得久），共用同一个池的链表之间 splice 是 O(1)。
+// 注意：不是线程安全的（与 ObjectPool 相同）。
+// ======================================================
+template<typename T>
+class PooledList {
+public:
+    struct Node : ListHook<> {
+        T value;
+
+        template<typename... Args>
+        explicit Node(Args &&... args) : value(std::forward<Args>(args)...) {
+        }
+    };
+
+    using NodePool = ObjectPool<Node>;
+    using Links = IntrusiveList<Node>;
+
+    // 迭代器：包一层 IntrusiveList 的迭代器，解引用得到 T
+    template<bool Const>
+    class Iter {
+        using Base = std::conditional_t<Const, typename Links::const_iterator, typename Links::iterator>;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T *, T *>;
+        using reference = std::conditional_t<Const, const T &, T &>;
+
+        Iter() = default;
+
+        explicit Iter(const Base base) : base_(base) {
+        }
+
+        // iterator -> const_iterator
+        template<bool C> requires (Const && !C)
+        Iter(const Iter<C> &other) : base_(other.base_) {
+        }
+
+        reference operator*() const { return base_->value; }
+        pointer operator->() const { return &base_->value; }
+
+        Iter &operator++() {
+            ++base_;
+            return *this;
+        }
+
+        Iter operator++(int) {
+            Iter old = *this;
+            ++base_;
+            return old;
+        }
+
+        Iter &operator--() {
+            --base_;
+            return *this;
+        }
+
+        Iter operator--(int) {
+            Iter old = *this;
+            --base_;
+            return old;
+        }
+
+        bool operator==(const Iter &other) const { return base_ == other.base_; }
+
+    private:
+        friend class PooledList;
+        friend class Iter<true>;
+        Base base_;
+    };
+
+    using value_type = T;
+    using iterator = Iter<false>;
+    using const_iterator = Iter<true>;
+
+    // 自带一个节点池
+    PooledList() : pool_(&ownPool_) {
+    }
+
+    // 与其他链表共用一个节点池
+    explicit PooledList(NodePool &pool) : pool_(&pool) {
+    }
+
+    PooledList(const PooledList &other) : PooledList() {
+        for (const T &x : other)
+            push_back(x);
+    }
+
+    PooledList &operator=(const PooledList &other) {
+        if (this == &other)
+            return *this;
+        clear();
+        for (const T &x : other)
+            push_back(x);
+        return *this;
+    }
+
+    ~PooledList() { clear(); }
+
+    // ----------------------------
+    // 插入 / 删除：节点来自池，删掉的节点还给池
+    // ----------------------------
+    template<typename... Args>
+    iterator emplace(const const_iterator pos, Args &&... args) {
+        Node *node = pool_->create(std::forward<Args>(args)...);
+        return iterator(links_.insert(pos.base_, *node));
+    }
+
+    template<typename... Args>
+    T &emplace_back(Args &&... args) { return *emplace(end(), std::forward<Args>(args)...); }
+
+    template<typename... Args>
+    T &emplace_front(Args &&... args) { return *emplace(begin(), std::forward<Args>(args)...); }
+
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+    void push_front(const T &value) { emplace_front(value); }
+    void push_front(T &&value) { emplace_front(std::move(value)); }
+    iterator insert(const const_iterator pos, const T &value) { return emplace(pos, value); }
+
+    iterator erase(const const_iterator pos) {
+        Node &node = const_cast<Node &>(*pos.base_);
+        const auto next = links_.erase(node);
+        pool_->destroy(&node);
+        return iterator(next);
+    }
+
+    void pop_front() {
+        if (empty())
+            throw std::out_of_range("list empty");
+        erase(begin());
+    }
+
+    void pop_back() {
+        if (empty())
+            throw std::out_of_range("list empty");
+        erase(--end());
+    }
+
+    void clear() {
+        while (!empty())
+            erase(begin());
+    }
+
+    // 把 other 的全部元素 / pos 处的一个元素搬到 pos 之前；两个链表必须共用同一个池
+    void splice(const const_iterator pos, PooledList &other) {
+        check_same_pool(other);
+        links_.splice(pos.base_, other.links_);
+    }
+
+    void splice(const const_iterator pos, PooledList &other, const const_iterator it) {
+        check_same_pool(other);
+        links_.splice(pos.base_, other.links_, const_cast<Node &>(*it.base_));
+    }
+
+    // ----------------------------
+    // 访问
+    // ----------------------------
+    T &front() { return links_.front().value; }
+    T &back() { return links_.back().value; }
+
+    [[nodiscard]] bool empty() const { return links_.empty(); }
+    [[nodiscard]] size_t size() const { return links_.size(); }
+    [[nodiscard]] const NodePool &pool() const { return *pool_; }
+
+    iterator begin() { return iterator(links_.begin()); }
+    iterator end() { return iterator(links_.end()); }
+    const_iterator begin() const { return const_iterator(links_.begin()); }
+    const_iterator end() const { return const_iterator(links_.end()); }
+
+private:
+    NodePool ownPool_{64, 4096};
+    NodePool *pool_;
+    Links links_;
+
+    void check_same_pool(const PooledList &other) const {
+        if (pool_ != other.pool_)
+            throw std::invalid_argument("splice between lists with different node pools");
+    }
+};
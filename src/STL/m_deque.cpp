@@ -0,0 +1,98 @@
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+
+#include "segmented_deque.h"
+#include "templates_vector.h"
+
+/*
+分段双端队列 Deque vs std::deque vs Vector
+  元素是 64 字节的消息，队列涨到 400 万条（256MB）：
+  一、增长：逐条 push_back。Vector 每次扩容都要搬动全部元素；两种 deque 只追加新块
+  二、顺序扫描：遍历求和。std::deque 的块只有 512 字节（8 条消息），Deque 默认 16KB
+  三、排空：逐条 pop_front（Vector 做不到 O(1)）
+  四、稳态队列：在 100 万条上下反复进出，Deque 的块在池子里循环使用，不再向系统要内存
+  五、迭代器稳定性：两端各插入 100 万条后，之前拿到的迭代器仍然指向原来的元素
+*/
+
+struct Message {
+    uint64_t id;
+    char payload[56];
+};
+
+using Clock = std::chrono::steady_clock;
+
+constexpr uint64_t kMessages = 4000000;
+
+double ms_since(const Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+template<typename Queue>
+void run(const char *name, Queue &q) {
+    auto start = Clock::now();
+    for (uint64_t i = 0; i < kMessages; ++i)
+        q.push_back(Message{i, {}});
+    const double grow = ms_since(start);
+
+    start = Clock::now();
+    uint64_t sum = 0;
+    for (const Message &m : q)
+        sum += m.id;
+    const double scan = ms_since(start);
+
+    std::cout << name << "\t增长: " << grow << " ms\t扫描: " << scan << " ms";
+    if constexpr (requires { q.pop_front(); }) {
+        start = Clock::now();
+        while (!q.empty())
+            q.pop_front();
+        std::cout << "\t排空: " << ms_since(start) << " ms";
+    }
+    std::cout << "\t(sum " << sum % 1000 << ")" << std::endl;
+}
+
+int main() {
+    {
+        Vector<Message> v;
+        run("Vector", v);
+    }
+    {
+        std::deque<Message> d;
+        run("std::deque", d);
+    }
+    {
+        Deque<Message> d;
+        run("Deque", d);
+        std::cout << "Deque 每块 " << d.block_size() << " 条消息，排空后池中空闲块: " << d.pool().available()
+                  << std::endl;
+    }
+
+    // 稳态队列：块在池子里循环
+    Deque<Message> q;
+    for (uint64_t i = 0; i < 1000000; ++i)
+        q.push_back(Message{i, {}});
+    const auto churn = [&q] {
+        for (uint64_t i = 0; i < 500000; ++i)
+            q.push_back(Message{i, {}});
+        for (uint64_t i = 0; i < 500000; ++i)
+            q.pop_front();
+    };
+    churn(); // 第一轮涨到 150 万条，池子补足需要的块
+    const size_t poolBefore = q.pool().capacity();
+    const auto start = Clock::now();
+    for (int round = 0; round < 10; ++round)
+        churn();
+    std::cout << "稳态 1000 万次进出: " << ms_since(start) << " ms，池容量 " << poolBefore << " -> "
+              << q.pool().capacity() << " 块" << std::endl;
+
+    // 迭代器稳定性
+    auto it = q.begin() + 12345;
+    const uint64_t id = it->id;
+    for (uint64_t i = 0; i < 1000000; ++i) {
+        q.push_back(Message{i, {}});
+        q.push_front(Message{i, {}});
+    }
+    std::cout << "两端各插入 100 万条后，迭代器仍指向 id " << it->id << "（原来是 " << id << "）" << std::endl;
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "flat_hash_map.h"
+
+/*
+FlatHashMap / FlatHashSet vs std::unordered_map / std::unordered_set
+  键是随机的 uint64_t，规模从 1K 到 1000 万（命令行参数可以改上限，例如 ./m_flat_hash_map 100000000，
+  1 亿个元素光 std::unordered_map 就要 4GB 以上内存），每个规模测：
+  一、插入 n 个键（不预留容量）
+  二、命中查找：按打乱的顺序查全部 n 个键
+  三、未命中查找：查 n 个不存在的键（FlatHashMap 遇到含空槽的组就停）
+  四、删除一半的键，再做一次命中查找（向后移位删除，没有墓碑，查找不会变慢）
+  最后用 string 键演示异构查找：用 string_view 直接查，不构造临时 std::string。
+  打印每次操作的平均纳秒数。默认 -O0 构建下函数调用开销占主导，比较请用 -O2 编译运行。
+*/
+
+using Clock = std::chrono::steady_clock;
+
+template<typename Fn>
+double ns_per_op(const size_t ops, Fn &&fn) {
+    const auto start = Clock::now();
+    fn();
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / static_cast<double>(ops);
+}
+
+template<typename Map>
+void bench_map(const char *name, const std::vector<uint64_t> &keys, const std::vector<uint64_t> &misses) {
+    const size_t n = keys.size();
+    Map m;
+    const double insert = ns_per_op(n, [&] {
+        for (const uint64_t k : keys)
+            m[k] = k;
+    });
+
+    std::vector<uint64_t> order(keys);
+    std::shuffle(order.begin(), order.end(), std::mt19937_64(3));
+    uint64_t sum = 0;
+    const double hit = ns_per_op(n, [&] {
+        for (const uint64_t k : order)
+            sum += m.find(k)->second;
+    });
+    size_t found = 0;
+    const double miss = ns_per_op(n, [&] {
+        for (const uint64_t k : misses)
+            found += m.count(k);
+    });
+    const double erase = ns_per_op(n / 2, [&] {
+        for (size_t i = 0; i < n / 2; ++i)
+            m.erase(order[i]);
+    });
+    const double hitAfter = ns_per_op(n - n / 2, [&] {
+        for (size_t i = n / 2; i < n; ++i)
+            sum += m.find(order[i])->second;
+    });
+    std::cout << "  " << name << "\t插入 " << insert << "\t命中 " << hit << "\t未命中 " << miss << "\t删除 " << erase
+              << "\t删后命中 " << hitAfter << " ns/op\t(" << sum % 10 + found << ")" << std::endl;
+}
+
+template<typename Set>
+void bench_set(const char *name, const std::vector<uint64_t> &keys, const std::vector<uint64_t> &misses) {
+    const size_t n = keys.size();
+    Set s;
+    const double insert = ns_per_op(n, [&] {
+        for (const uint64_t k : keys)
+            s.insert(k);
+    });
+    size_t found = 0;
+    const double hit = ns_per_op(n, [&] {
+        for (const uint64_t k : keys)
+            found += s.count(k);
+    });
+    const double miss = ns_per_op(n, [&] {
+        for (const uint64_t k : misses)
+            found += s.count(k);
+    });
+    std::cout << "  " << name << "\t插入 " << insert << "\t命中 " << hit << "\t未命中 " << miss << " ns/op\t(" << found
+              << ")" << std::endl;
+}
+
+int main(const int argc, char **argv) {
+    const size_t maxN = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::mt19937_64 rng(7);
+    for (size_t n = 1000; n <= maxN; n *= 10) {
+        // 命中键都是奇数，未命中键都是偶数
+        std::vector<uint64_t> keys(n), misses(n);
+        for (size_t i = 0; i < n; ++i) {
+            keys[i] = rng() | 1;
+            misses[i] = rng() & ~uint64_t{1};
+        }
+        std::cout << "n = " << n << std::endl;
+        bench_map<std::unordered_map<uint64_t, uint64_t> >("std::unordered_map", keys, misses);
+        bench_map<FlatHashMap<uint64_t, uint64_t> >("FlatHashMap\t", keys, misses);
+        bench_set<std::unordered_set<uint64_t> >("std::unordered_set", keys, misses);
+        bench_set<FlatHashSet<uint64_t> >("FlatHashSet\t", keys, misses);
+    }
+
+    // 异构查找：std::string 键，用 string_view 查
+    FlatHashMap<std::string, int> words;
+    std::vector<std::string> names(100000);
+    for (size_t i = 0; i < names.size(); ++i) {
+        names[i] = "user_" + std::to_string(i * 7919) + "_long_enough_to_skip_sso";
+        words[names[i]] = static_cast<int>(i);
+    }
+    std::unordered_map<std::string, int> stdWords(words.begin(), words.end());
+    int64_t sum = 0;
+    const double viaString = ns_per_op(names.size(), [&] {
+        for (const std::string &name : names)
+            sum += stdWords.find(std::string(std::string_view(name)))->second; // 先构造临时 string
+    });
+    const double viaView = ns_per_op(names.size(), [&] {
+        for (const std::string &name : names)
+            sum += words.find(std::string_view(name))->second;
+    });
+    std::cout << "string 键查找  std::unordered_map(临时 string): " << viaString
+              << " ns/op  FlatHashMap(string_view): " << viaView << " ns/op  (" << sum % 10 << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <list>
+#include <random>
+#include <vector>
+
+#include "intrusive_list.h"
+
+/*
+IntrusiveList / PooledList vs std::list
+  链表里保持 10 万个元素，做 1000 万次"删掉一个随机元素、在尾部插入一个新元素"（LRU 淘汰、定时器重排的典型动作）：
+  一、std::list：每次插入 new 一个节点，删除 delete 一个节点；按保存的迭代器删除
+  二、PooledList：接口相同，节点从 ObjectPool 的自由链表取，删掉的节点回到池里
+  三、IntrusiveList：元素放在一个现成的数组里（就像放在哈希表里），钩子在元素内部，
+      删除 = 从链表摘下，插入 = 重新挂上，没有任何分配
+  打印每次操作的纳秒数和 PooledList 池的容量（稳定后不再增长）。
+  最后演示一个元素同时挂在 LRU 和定时器两条链表上。
+*/
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kLive = 100000;
+constexpr size_t kOps = 10000000;
+
+struct Entry : ListHook<> {
+    uint64_t key = 0;
+    uint64_t payload[3] = {};
+};
+
+struct Victims {
+    std::vector<uint32_t> index; // 每次删掉第几个槽位里的元素
+
+    Victims() : index(kOps) {
+        std::mt19937 rng(5);
+        for (uint32_t &i : index)
+            i = rng() % kLive;
+    }
+};
+
+double ns_per_op(const Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / kOps;
+}
+
+// std::list 和 PooledList：slots[i] 是第 i 个槽位里元素的迭代器
+template<typename List>
+double churn(List &list, const Victims &victims) {
+    std::vector<typename List::iterator> slots(kLive);
+    for (size_t i = 0; i < kLive; ++i)
+        slots[i] = list.insert(list.end(), Entry{{}, i, {}});
+
+    const auto start = Clock::now();
+    for (size_t op = 0; op < kOps; ++op) {
+        const uint32_t i = victims.index[op];
+        list.erase(slots[i]);
+        slots[i] = list.insert(list.end(), Entry{{}, op, {}});
+    }
+    return ns_per_op(start);
+}
+
+double churn_intrusive(const Victims &victims) {
+    std::vector<Entry> entries(kLive);
+    IntrusiveList<Entry> list;
+    for (Entry &e : entries)
+        list.push_back(e);
+
+    const auto start = Clock::now();
+    for (size_t op = 0; op < kOps; ++op) {
+        Entry &e = entries[victims.index[op]];
+        list.erase(e);
+        e.key = op;
+        list.push_back(e);
+    }
+    return ns_per_op(start);
+}
+
+// 一个连接同时在 LRU 链和定时器链上
+struct LruTag {
+};
+
+struct TimerTag {
+};
+
+struct Connection : ListHook<LruTag>, ListHook<TimerTag> {
+    int fd;
+
+    explicit Connection(const int f) : fd(f) {
+    }
+};
+
+int main() {
+    const Victims victims;
+
+    std::list<Entry> stdList;
+    std::cout << "std::list\t" << churn(stdList, victims) << " ns/op" << std::endl;
+
+    PooledList<Entry> pooled;
+    std::cout << "PooledList\t" << churn(pooled, victims) << " ns/op\t池容量 " << pooled.pool().capacity()
+              << " 个节点（链表长度 " << pooled.size() << "）" << std::endl;
+
+    std::cout << "IntrusiveList\t" << churn_intrusive(victims) << " ns/op" << std::endl;
+
+    std::vector<Connection> conns;
+    for (int fd = 3; fd < 8; ++fd)
+        conns.emplace_back(fd);
+    IntrusiveList<Connection, LruTag> lru;
+    IntrusiveList<Connection, TimerTag> timers;
+    for (Connection &c : conns) {
+        lru.push_back(c);
+        timers.push_front(c);
+    }
+    lru.splice(lru.begin(), lru, conns[3]); // fd 6 被访问，挪到 LRU 最前
+    lru.erase(conns[1]); // fd 4 关闭：两条链上都摘掉
+    timers.erase(conns[1]);
+    std::cout << "LRU:";
+    for (const Connection &c : lru)
+        std::cout << " " << c.fd;
+    std::cout << "  定时器:";
+    for (const Connection &c : timers)
+        std::cout << " " << c.fd;
+    std::cout << std::endl;
+    return 0;
+}
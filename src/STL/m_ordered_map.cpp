@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "btree.h"
+#include "flat_map.h"
+
+/*
+有序容器：std::map / std::set（红黑树） vs FlatMap（有序数组） vs BTreeMap / BTreeSet（B 树）
+  键是随机的 uint64_t，规模 1K、10 万、100 万（命令行参数可以改上限，例如 ./m_ordered_map 10000000）：
+  一、插入：逐个插入 n 个随机键。FlatMap 逐个插入是 O(n²)，只在 10 万以内测；
+      另测 FlatMap 的批量构造（排序 + 去重）
+  二、查找：按随机顺序查全部 n 个键
+  三、顺序遍历：从头到尾求和
+  四、混合：查找 / 插入 / 删除各占三分之一（FlatMap 不测）
+  打印每次操作的平均纳秒数和 B 树的高度。默认 -O0 构建下函数调用开销占主导，比较请用 -O2 编译运行。
+  最后检查：参数引用树里元素时插入 / 删除仍然正确（根节点正好满、插入会先拆分的情况），
+  以及 Multi 版本和按迭代器删除与 std::multimap 的结果一致。
+*/
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kFlatInsertLimit = 100000;
+
+template<typename Fn>
+double ns_per_op(const size_t ops, Fn &&fn) {
+    const auto start = Clock::now();
+    fn();
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / static_cast<double>(ops);
+}
+
+template<typename Map>
+void bench_lookup_scan(Map &m, const std::vector<uint64_t> &order) {
+    uint64_t sum = 0;
+    const double find = ns_per_op(order.size(), [&] {
+        for (const uint64_t k : order)
+            sum += m.find(k)->second;
+    });
+    const double scan = ns_per_op(m.size(), [&] {
+        for (const auto &kv : m)
+            sum += kv.second;
+    });
+    std::cout << "\t查找 " << find << "\t遍历 " << scan << " ns/op\t(" << sum % 10 << ")";
+}
+
+template<typename Map>
+void bench_map(const char *name, const std::vector<uint64_t> &keys, const std::vector<uint64_t> &order) {
+    Map m;
+    const double insert = ns_per_op(keys.size(), [&] {
+        for (const uint64_t k : keys)
+            m[k] = k;
+    });
+    std::cout << "  " << name << "\t插入 " << insert;
+    bench_lookup_scan(m, order);
+    if constexpr (requires { m.height(); })
+        std::cout << "\t树高 " << m.height();
+    std::cout << std::endl;
+}
+
+// 混合负载：查找 / 插入 / 删除轮流进行，键的集合大小基本不变
+template<typename Map>
+void bench_mixed(const char *name, const std::vector<uint64_t> &keys) {
+    Map m;
+    for (const uint64_t k : keys)
+        m[k] = k;
+    std::mt19937_64 rng(17);
+    uint64_t sum = 0;
+    const double mixed = ns_per_op(keys.size() * 3, [&] {
+        for (const uint64_t k : keys) {
+            sum += m.count(k);
+            m.erase(k);
+            m[rng()] = k;
+        }
+    });
+    std::cout << "  " << name << "\t混合 " << mixed << " ns/op\t(" << sum % 10 << ")" << std::endl;
+}
+
+template<typename Set>
+void bench_set(const char *name, const std::vector<uint64_t> &keys, const std::vector<uint64_t> &order) {
+    Set s;
+    const double insert = ns_per_op(keys.size(), [&] {
+        for (const uint64_t k : keys)
+            s.insert(k);
+    });
+    size_t found = 0;
+    const double find = ns_per_op(order.size(), [&] {
+        for (const uint64_t k : order)
+            found += s.count(k);
+    });
+    uint64_t sum = 0;
+    const double scan = ns_per_op(s.size(), [&] {
+        for (const uint64_t k : s)
+            sum += k;
+    });
+    std::cout << "  " << name << "\t插入 " << insert << "\t查找 " << find << "\t遍历 " << scan << " ns/op\t("
+              << found + sum % 10 << ")" << std::endl;
+}
+
+int main(const int argc, char **argv) {
+    const size_t maxN = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::mt19937_64 rng(7);
+    for (size_t n = 1000; n <= maxN; n *= n < 100000 ? 100 : 10) {
+        std::vector<uint64_t> keys(n);
+        for (uint64_t &k : keys)
+            k = rng();
+        std::vector<uint64_t> order(keys);
+        std::shuffle(order.begin(), order.end(), rng);
+
+        std::cout << "n = " << n << "（BTreeMap 每节点 " << BTreeMap<uint64_t, uint64_t>::node_capacity()
+                  << " 个元素，BTreeSet 每节点 " << BTreeSet<uint64_t>::node_capacity() << " 个）" << std::endl;
+        bench_map<std::map<uint64_t, uint64_t> >("std::map", keys, order);
+        if (n <= kFlatInsertLimit)
+            bench_map<FlatMap<uint64_t, uint64_t> >("FlatMap", keys, order);
+
+        std::vector<std::pair<uint64_t, uint64_t> > items;
+        items.reserve(n);
+        for (const uint64_t k : keys)
+            items.emplace_back(k, k);
+        FlatMap<uint64_t, uint64_t> flat;
+        const double build = ns_per_op(n, [&] { flat = FlatMap<uint64_t, uint64_t>(std::move(items)); });
+        std::cout << "  FlatMap 批量\t构造 " << build;
+        bench_lookup_scan(flat, order);
+        std::cout << std::endl;
+
+        bench_map<BTreeMap<uint64_t, uint64_t> >("BTreeMap", keys, order);
+        bench_set<std::set<uint64_t> >("std::set", keys, order);
+        bench_set<BTreeSet<uint64_t> >("BTreeSet", keys, order);
+        bench_mixed<std::map<uint64_t, uint64_t> >("std::map", keys);
+        bench_mixed<BTreeMap<uint64_t, uint64_t> >("BTreeMap", keys);
+    }
+
+    // 键引用树里的元素：根节点正好满，下一次插入会先拆分根节点
+    BTreeMap<std::string, int> names;
+    for (size_t i = 0; i < names.node_capacity(); ++i)
+        names[std::string(40, static_cast<char>('a' + i))] = static_cast<int>(i);
+    const bool inserted = names.try_emplace((--names.end())->first, 99).second;
+    names[names.begin()->first] = -1;
+    const size_t erased = names.erase(names.begin()->first);
+    std::cout << "别名键: try_emplace 新插入 " << inserted << "，erase 删掉 " << erased << " 个，剩 " << names.size()
+              << " 个（应为 0、1、" << names.node_capacity() - 1 << "）" << std::endl;
+
+    // Multi 版本与按迭代器删除，与 std::multimap 对照
+    std::multimap<int, int> ref;
+    BTreeMultiMap<int, int> btree;
+    FlatMultiMap<int, int> flat;
+    std::mt19937 small(3);
+    for (int i = 0; i < 20000; ++i) {
+        const int k = static_cast<int>(small() % 500);
+        ref.insert({k, i});
+        btree.insert({k, i});
+        flat.insert({k, i});
+    }
+    for (int i = 0; i < 5000; ++i) {
+        const size_t at = small() % ref.size();
+        ref.erase(std::next(ref.begin(), static_cast<std::ptrdiff_t>(at)));
+        btree.erase(std::next(btree.begin(), static_cast<std::ptrdiff_t>(at)));
+        flat.erase(flat.begin() + static_cast<std::ptrdiff_t>(at));
+        if (i % 20 != 0)
+            continue;
+        const int k = static_cast<int>(small() % 500);
+        const size_t n = ref.erase(k);
+        if (btree.erase(k) != n || flat.erase(k) != n)
+            std::cout << "erase(" << k << ") 个数不一致" << std::endl;
+    }
+    const auto same = [&ref](const auto &m) {
+        return std::equal(ref.begin(), ref.end(), m.begin(), m.end(), [](const auto &a, const auto &b) {
+            return a.first == b.first && a.second == b.second;
+        });
+    };
+    std::cout << "Multi 版本与 std::multimap 一致: BTreeMultiMap " << same(btree) << "  FlatMultiMap " << same(flat)
+              << "（" << ref.size() << " 个元素）" << std::endl;
+    return 0;
+}
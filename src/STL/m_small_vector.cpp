@@ -0,0 +1,112 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "small_vector.h"
+#include "templates_vector.h"
+
+/*
+SmallVector 演示：解析请求
+  每个请求形如 "GET /api/v1/users/42/orders?page=2&size=20&sort=desc"，
+  解析出路径分段和查询参数两个小列表。绝大多数请求只有几个分段、几个参数，
+  偶尔有超长的请求（这里每 100 个一个）超过 8 个，让 SmallVector 溢出到堆上。
+  比较：
+    Vector<T>          构造时就 malloc（默认容量 10），每个列表至少一次分配
+    SmallVector<T, 8>  8 个以内完全在对象内部
+  统计每种写法向配置器申请内存的次数，以及总耗时。
+  最后演示溢出后 erase_if + shrink_to_fit 回到内联缓冲区，以及移动。
+*/
+
+constexpr int kRequests = 1000000;
+
+// 统计分配次数的配置器
+template<typename T>
+struct CountingAllocator : Allocator<T> {
+    static inline size_t calls = 0;
+
+    static T *allocate(const size_t n) {
+        ++calls;
+        return Allocator<T>::allocate(n);
+    }
+};
+
+using Param = std::pair<std::string_view, std::string_view>;
+
+// 按分隔符切分，把每一段交给 f
+template<typename F>
+void split(std::string_view s, const char sep, F f) {
+    while (!s.empty()) {
+        const size_t pos = s.find(sep);
+        const std::string_view part = s.substr(0, pos);
+        if (!part.empty())
+            f(part);
+        if (pos == std::string_view::npos)
+            break;
+        s.remove_prefix(pos + 1);
+    }
+}
+
+template<typename Segments, typename Params>
+size_t parse(std::string_view request) {
+    request.remove_prefix(request.find(' ') + 1);
+    const size_t q = request.find('?');
+    const std::string_view path = request.substr(0, q);
+    const std::string_view query = q == std::string_view::npos ? std::string_view() : request.substr(q + 1);
+
+    Segments segments;
+    Params params;
+    split(path, '/', [&](std::string_view seg) { segments.push_back(seg); });
+    split(query, '&', [&](std::string_view kv) {
+        const size_t eq = kv.find('=');
+        params.emplace_back(kv.substr(0, eq), eq == std::string_view::npos ? std::string_view() : kv.substr(eq + 1));
+    });
+
+    size_t check = segments.size() * 31 + params.size();
+    for (const std::string_view seg : segments)
+        check += seg.size();
+    return check;
+}
+
+template<typename Segments, typename Params>
+double run(const std::string &normal, const std::string &huge, size_t &check) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kRequests; ++i)
+        check += parse<Segments, Params>(i % 100 == 0 ? huge : normal);
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    const std::string normal = "GET /api/v1/users/42/orders?page=2&size=20&sort=desc";
+    std::string huge = "GET /static/assets/js/vendor/lib/a/b/c/d/e/bundle.js?";
+    for (int i = 0; i < 12; ++i)
+        huge += "k" + std::to_string(i) + "=v&";
+
+    size_t heapCheck = 0, smallCheck = 0;
+    const double heap = run<Vector<std::string_view, CountingAllocator<std::string_view>>,
+                            Vector<Param, CountingAllocator<Param>>>(normal, huge, heapCheck);
+    const size_t heapCalls = CountingAllocator<std::string_view>::calls + CountingAllocator<Param>::calls;
+    CountingAllocator<std::string_view>::calls = CountingAllocator<Param>::calls = 0;
+
+    const double small = run<SmallVector<std::string_view, 8, CountingAllocator<std::string_view>>,
+                             SmallVector<Param, 8, CountingAllocator<Param>>>(normal, huge, smallCheck);
+    const size_t smallCalls = CountingAllocator<std::string_view>::calls + CountingAllocator<Param>::calls;
+
+    std::cout << "分配次数  Vector: " << heapCalls << "  SmallVector<8>: " << smallCalls << "  （省掉 "
+              << heapCalls - smallCalls << " 次）" << std::endl;
+    std::cout << "耗时      Vector: " << heap << " s  SmallVector<8>: " << small << " s  加速 " << heap / small
+              << "x" << std::endl;
+    std::cout << "校验和一致: " << std::boolalpha << (heapCheck == smallCheck) << std::endl;
+
+    SmallVector<int, 8> ids;
+    for (int i = 0; i < 20; ++i)
+        ids.push_back(i);
+    std::cout << "20 个元素: 内联 " << ids.is_inline() << " 容量 " << ids.capacity();
+    ids.erase_if([](const int x) { return x % 4 != 0; });
+    ids.shrink_to_fit();
+    std::cout << "  -> erase_if + shrink_to_fit 后 " << ids.size() << " 个: 内联 " << ids.is_inline() << " 容量 "
+              << ids.capacity();
+    const SmallVector<int, 8> moved = std::move(ids);
+    std::cout << "  -> 移动后原对象 " << ids.size() << " 个，新对象 " << moved.size() << " 个" << std::endl;
+    return 0;
+}
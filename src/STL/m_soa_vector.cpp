@@ -0,0 +1,122 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <span>
+
+#include "soa_vector.h"
+#include "templates_vector.h"
+#include "../simd/simd_reduce.h"
+
+/*
+SoAVector vs Vector<AlignedStruct>
+  AlignedStruct 同 m_sizeof.cpp：{char a; int b; short c;}，填充后 12 字节，有效数据 7 字节。
+  1000 万条记录，分别存成 AoS（Vector<AlignedStruct>）和 SoA（SoAVector<char, int, short>）：
+  一、单字段扫描：sum(b)、count(c > 500)
+       AoS 循环 / SoA 列循环 / SoA 列交给 simd::sum（int 列）
+  二、整行访问：对每行算 a + b + c，AoS 循环 / SoA 行代理 / SoA 按下标取三列
+  打印耗时、每种方式实际扫过的字节数。
+  注意：默认 -O0 构建下 span / 行代理的函数调用开销占主导，比较布局请用 -O2 编译运行。
+*/
+
+struct AlignedStruct {
+    char a;
+    int b;
+    short c;
+};
+
+using Clock = std::chrono::steady_clock;
+using Records = SoAVector<char, int, short>;
+
+constexpr size_t kRecords = 10000000;
+constexpr int kRepeat = 5;
+
+template<typename Fn>
+double ms(Fn &&fn) {
+    const auto start = Clock::now();
+    for (int r = 0; r < kRepeat; ++r)
+        fn();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / kRepeat;
+}
+
+int main() {
+    Vector<AlignedStruct> aos(kRecords);
+    Records soa(kRecords);
+    std::mt19937 rng(11);
+    for (size_t i = 0; i < kRecords; ++i) {
+        const AlignedStruct s{static_cast<char>(rng() % 100), static_cast<int>(rng() % 100000),
+                              static_cast<short>(rng() % 1000)};
+        aos.push_back(s);
+        soa.push_back(s.a, s.b, s.c);
+    }
+    std::cout << "每条记录  AoS: " << sizeof(AlignedStruct) << " 字节  SoA: "
+              << sizeof(char) + sizeof(int) + sizeof(short) << " 字节" << std::endl;
+
+    // 单字段扫描：sum(b)
+    volatile int64_t sink = 0;
+    const AlignedStruct *rows = aos.data();
+    const double aosSum = ms([&] {
+        int64_t s = 0;
+        for (size_t i = 0; i < kRecords; ++i)
+            s += rows[i].b;
+        sink = s;
+    });
+    const std::span<const int> bs = soa.column<1>();
+    const double soaSum = ms([&] {
+        int64_t s = 0;
+        for (const int b : bs)
+            s += b;
+        sink = s;
+    });
+    const double simdSum = ms([&] { sink = simd::sum(std::span<const int32_t>(bs)); });
+    std::cout << "sum(b)       AoS: " << aosSum << " ms（扫 " << kRecords * sizeof(AlignedStruct) / 1000000
+              << " MB）  SoA 列: " << soaSum << " ms  SoA 列 + simd::sum: " << simdSum << " ms（扫 "
+              << kRecords * sizeof(int) / 1000000 << " MB）" << std::endl;
+
+    // 单字段扫描：count(c > 500)
+    const double aosCount = ms([&] {
+        size_t n = 0;
+        for (size_t i = 0; i < kRecords; ++i)
+            n += rows[i].c > 500;
+        sink = static_cast<int64_t>(n);
+    });
+    const std::span<const short> cs = soa.column<2>();
+    const double soaCount = ms([&] {
+        size_t n = 0;
+        for (const short c : cs)
+            n += c > 500;
+        sink = static_cast<int64_t>(n);
+    });
+    std::cout << "count(c>500) AoS: " << aosCount << " ms  SoA 列: " << soaCount << " ms" << std::endl;
+
+    // 整行访问
+    const double aosRow = ms([&] {
+        int64_t s = 0;
+        for (size_t i = 0; i < kRecords; ++i)
+            s += rows[i].a + rows[i].b + rows[i].c;
+        sink = s;
+    });
+    const Records &view = soa;
+    const double soaProxy = ms([&] {
+        int64_t s = 0;
+        for (const auto [a, b, c] : view)
+            s += a + b + c;
+        sink = s;
+    });
+    const std::span<const char> as = soa.column<0>();
+    const double soaIndex = ms([&] {
+        int64_t s = 0;
+        for (size_t i = 0; i < kRecords; ++i)
+            s += as[i] + bs[i] + cs[i];
+        sink = s;
+    });
+    std::cout << "整行 a+b+c   AoS: " << aosRow << " ms  SoA 行代理: " << soaProxy << " ms  SoA 三列下标: "
+              << soaIndex << " ms" << std::endl;
+
+    // 行代理可写
+    auto [a, b, c] = soa[0];
+    b = 42;
+    soa[1] = {'x', 7, 8};
+    std::cout << "soa[0].b = " << soa[0].get<1>() << "  soa[1].b = " << soa[1].get<1>() << std::endl;
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "templates_vector.h"
+
+/*
+批量删除 / 插入 vs vector.cpp 里的逐个 erase / insert
+  vector.cpp 用 it = vec.erase(it) 删偶数、用 vec.insert(it, *it - 1) 在偶数前插入，
+  每次调用都要挪动整个尾部，总共 O(n²)。
+  Vector::erase_if / insert_if 一趟完成，O(n)。
+  逐个版本只跑 20 万个元素（平方增长，放大到 1000 万要一个小时左右），批量版本跑 1000 万个。
+  两种写法的结果用元素个数 + 按顺序累加的校验和比较，顺序或数值有任何不同都会发现。
+*/
+
+using Clock = std::chrono::steady_clock;
+
+double seconds_since(const Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+template<typename V>
+V make_data(const size_t n) {
+    V v;
+    v.reserve(n);
+    std::mt19937 rng(5);
+    for (size_t i = 0; i < n; ++i)
+        v.push_back(static_cast<int>(rng() % 1000));
+    return v;
+}
+
+const auto isEven = [](const int x) { return x % 2 == 0; };
+
+// 结果摘要：元素个数 + 与顺序相关的校验和（FNV-1a），计时结束之后再算
+struct Digest {
+    size_t size = 0;
+    uint64_t hash = 14695981039346656037ull;
+
+    bool operator==(const Digest &) const = default;
+};
+
+template<typename V>
+Digest digest(const V &v) {
+    Digest d;
+    for (const int x : v) {
+        d.hash = (d.hash ^ static_cast<uint32_t>(x)) * 1099511628211ull;
+        ++d.size;
+    }
+    return d;
+}
+
+// vector.cpp 的写法
+double one_by_one(const size_t n, Digest &result) {
+    auto v = make_data<std::vector<int>>(n);
+    const auto start = Clock::now();
+    for (auto it = v.begin(); it != v.end();) {
+        if (*it % 3 == 0)
+            it = v.erase(it);
+        else
+            ++it;
+    }
+    for (auto it = v.begin(); it != v.end(); ++it) {
+        if (isEven(*it)) {
+            it = v.insert(it, *it - 1);
+            ++it;
+        }
+    }
+    const double elapsed = seconds_since(start);
+    result = digest(v);
+    return elapsed;
+}
+
+double bulk(const size_t n, Digest &result) {
+    auto v = make_data<Vector<int>>(n);
+    const auto start = Clock::now();
+    v.erase_if([](const int x) { return x % 3 == 0; });
+    v.insert_if(isEven, [](const int x) { return x - 1; });
+    const double elapsed = seconds_since(start);
+    result = digest(v);
+    return elapsed;
+}
+
+int main() {
+    for (const size_t n : {50000ul, 100000ul, 200000ul}) {
+        Digest a, b;
+        const double slow = one_by_one(n, a);
+        const double fast = bulk(n, b);
+        std::cout << n << " 个元素  逐个 erase/insert: " << slow << " s   erase_if/insert_if: " << fast
+                  << " s   结果一致（个数 + 校验和）: " << std::boolalpha << (a == b) << std::endl;
+    }
+
+    Digest big;
+    const double seconds = bulk(10000000, big);
+    std::cout << "10000000 个元素  erase_if/insert_if: " << seconds << " s（剩 " << big.size << " 个）" << std::endl;
+
+    // 区间插入与容量控制
+    Vector<int> v(4);
+    v.reserve(32);
+    const std::vector<int> block = {7, 8, 9, 10, 11, 12};
+    v.insert(v.begin(), block.begin(), block.end());
+    v.insert(v.begin() + 3, block.begin(), block.begin() + 2);
+    std::cout << "区间插入后: ";
+    for (const int x : v)
+        std::cout << x << " ";
+    std::cout << " size " << v.size() << " capacity " << v.capacity();
+    v.shrink_to_fit();
+    std::cout << " -> shrink_to_fit 后 capacity " << v.capacity() << std::endl;
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "templates_vector.h"
+
+/*
+Vector 扩容的代价
+  从容量 1 开始逐个 push_back，扩容 log2(n) 次，每次都要把旧元素搬到新内存：
+    std::string  移动构造是 noexcept 的，扩容时移动（只搬指针），不再深拷贝字符串
+    Pod          平凡可拷贝，扩容时整块 memcpy
+    Legacy       移动构造没有 noexcept，为了强异常保证只能拷贝（和 std::vector 一样）
+  和 std::vector 比较耗时，并统计 Legacy 在扩容中被拷贝了多少次。
+*/
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kElements = 200000;
+constexpr int kRounds = 10;
+
+struct Pod {
+    int id;
+    double values[6];
+};
+
+struct Legacy {
+    static inline size_t copies = 0;
+    std::string name;
+
+    explicit Legacy(std::string n) : name(std::move(n)) {
+    }
+
+    Legacy(const Legacy &other) : name(other.name) { ++copies; }
+
+    Legacy(Legacy &&other) : name(std::move(other.name)) {
+    } // 没有 noexcept
+};
+
+std::string make_string(int i) {
+    return "a-string-long-enough-to-live-on-the-heap-" + std::to_string(i);
+}
+
+template<typename Container, typename Make>
+double grow(Make make) {
+    const auto start = Clock::now();
+    for (int r = 0; r < kRounds; ++r) {
+        Container v(1);
+        for (int i = 0; i < kElements; ++i)
+            v.push_back(make(i));
+    }
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// std::vector 的构造参数是元素个数而不是容量，包一层保持同样的起点
+template<typename T>
+struct StdVector : std::vector<T> {
+    explicit StdVector(size_t cap) { this->reserve(cap); }
+};
+
+int main() {
+    const double a = grow<Vector<std::string>>(make_string);
+    const double b = grow<StdVector<std::string>>(make_string);
+    std::cout << "std::string  Vector: " << a << " s   std::vector: " << b << " s" << std::endl;
+
+    const auto pod = [](int i) { return Pod{i, {}}; };
+    const double c = grow<Vector<Pod>>(pod);
+    const double d = grow<StdVector<Pod>>(pod);
+    std::cout << "Pod          Vector: " << c << " s   std::vector: " << d << " s" << std::endl;
+
+    const auto legacy = [](int i) { return Legacy(make_string(i)); };
+    const double e = grow<Vector<Legacy>>(legacy);
+    const size_t vectorCopies = Legacy::copies;
+    Legacy::copies = 0;
+    const double f = grow<StdVector<Legacy>>(legacy);
+    std::cout << "Legacy       Vector: " << e << " s   std::vector: " << f << " s   扩容拷贝次数: "
+              << vectorCopies / kRounds << " / " << Legacy::copies / kRounds << " 每轮" << std::endl;
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <chrono>
+#include <execution>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <ranges>
+
+#include "small_vector.h"
+#include "templates_vector.h"
+
+/*
+Vector 的随机访问迭代器
+  一、编译期检查：iterator / const_iterator 满足 std::contiguous_iterator，Vector 满足 std::ranges::contiguous_range
+  二、标准算法：std::sort、std::lower_bound、std::ranges::sort / find、反向迭代器、通过迭代器修改元素
+  三、并行算法：同一份数据分别用 std::sort 串行和 std::sort(std::execution::par_unseq) 排序，
+     再用 std::reduce(par_unseq) 求和（libstdc++ 的并行后端是 TBB，单核机器上看不出加速）
+*/
+
+using Vec = Vector<int>;
+static_assert(std::contiguous_iterator<Vec::iterator>);
+static_assert(std::contiguous_iterator<Vec::const_iterator>);
+static_assert(std::ranges::contiguous_range<Vec>);
+static_assert(std::ranges::contiguous_range<const Vec>);
+static_assert(std::ranges::contiguous_range<SmallVector<int, 8>>);
+static_assert(std::is_convertible_v<Vec::iterator, Vec::const_iterator>);
+
+constexpr int kElements = 5000000;
+
+Vec random_vector(const int n) {
+    Vec v(n);
+    std::mt19937 rng(1);
+    for (int i = 0; i < n; ++i)
+        v.push_back(static_cast<int>(rng() % 1000000));
+    return v;
+}
+
+template<typename Sort>
+double timed_sort(Sort sort) {
+    Vec v = random_vector(kElements);
+    const auto start = std::chrono::steady_clock::now();
+    sort(v);
+    const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (!std::is_sorted(v.cbegin(), v.cend()))
+        std::cout << "没有排好序！" << std::endl;
+    return s;
+}
+
+int main() {
+    // 标准算法
+    Vec v = random_vector(20);
+    std::sort(v.begin(), v.end());
+    for (int &x : v)
+        x += 1; // 可写的迭代器
+    const auto it = std::lower_bound(v.cbegin(), v.cend(), 500000);
+    std::cout << "第一个 >= 500000 的下标: " << it - v.begin() << std::endl;
+
+    std::ranges::sort(v, std::greater<>());
+    std::cout << "降序: ";
+    for (const int x : v | std::views::take(5))
+        std::cout << x << " ";
+    std::cout << "...  最小值（反向迭代器）: " << *std::make_reverse_iterator(v.end()) << std::endl;
+
+    SmallVector<int, 8> small;
+    for (const int x : {5, 3, 9, 1})
+        small.push_back(x);
+    std::ranges::sort(small);
+    std::cout << "SmallVector 排序后: ";
+    for (const int x : small)
+        std::cout << x << " ";
+    std::cout << " 含 9: " << std::boolalpha << (std::ranges::find(small, 9) != small.end()) << std::endl;
+
+    // 并行算法
+    const double serial = timed_sort([](Vec &x) { std::sort(x.begin(), x.end()); });
+    const double parallel = timed_sort([](Vec &x) { std::sort(std::execution::par_unseq, x.begin(), x.end()); });
+    std::cout << kElements << " 个 int 排序  串行: " << serial << " s  par_unseq: " << parallel << " s" << std::endl;
+
+    const Vec data = random_vector(kElements);
+    const long long sum = std::reduce(std::execution::par_unseq, data.begin(), data.end(), 0LL);
+    std::cout << "par_unseq reduce 求和: " << sum << "  与 accumulate 一致: "
+              << (sum == std::accumulate(data.begin(), data.end(), 0LL)) << std::endl;
+    return 0;
+}
@@ -0,0 +1,325 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "templates_vector.h"
+#include "../OOD/object_pool.h"
+
+// ======================================================
+// 分段双端队列 Deque<T, BlockSize>
+// 和 sort_vector.cpp 里描述的 std::deque 一样：一张 map（指针数组）指向若干个固定大小的块，
+// 元素放在块里，两端 push/pop 都是 O(1)，元素本身永远不搬动。不同之处：
+//   - 块的大小可调：BlockSize 是每块的元素个数（2 的幂），默认约 16KB 一块；
+//     libstdc++ 的块只有 512 字节，百万级队列顺序扫描时每 512 字节就要跳一次 map，预取效果差
+//   - 块从 ObjectPool 申请，弹空的块还给池子，下次增长直接复用（也可以几个队列共用一个池）
+//   - 迭代器记录的是元素的"绝对位置"而不是 map 里的指针：两端增长时 map 会重新分配，
+//     std::deque 的迭代器因此全部失效，而这里的迭代器仍然有效（指向的元素没被弹出即可）
+// 绝对位置：第一个元素的位置从 kOrigin 开始，push_front 时减一，push_back 时加一；
+// 位置 p 在第 p / BlockSize 块的第 p % BlockSize 个槽位（移位和掩码即可算出）。
+// 注意：不是线程安全的（与 ObjectPool 相同）。
+// ======================================================
+template<typename T>
+constexpr size_t default_block_size() {
+    return std::bit_floor(std::max<size_t>(16, 16384 / sizeof(T)));
+}
+
+template<typename T, size_t BlockSize = default_block_size<T>()>
+class Deque {
+    static_assert(std::has_single_bit(BlockSize), "BlockSize must be a power of two");
+
+public:
+    // 一个块：BlockSize 个 T 的未初始化存储（空的构造函数：从池里取块时不清零）
+    struct Block {
+        Block() {
+        }
+
+        alignas(T) unsigned char storage[BlockSize * sizeof(T)];
+    };
+
+    using BlockPool = ObjectPool<Block>;
+
+    template<bool Const>
+    class Iter;
+    using value_type = T;
+    using iterator = Iter<false>;
+    using const_iterator = Iter<true>;
+
+    // 自带一个块池
+    Deque() : pool_(&ownPool_) {
+    }
+
+    // 与其他队列共用一个块池（池必须比队列活得久）
+    explicit Deque(BlockPool &pool) : pool_(&pool) {
+    }
+
+    Deque(const Deque &other) : Deque() {
+        for (const T &x : other)
+            push_back(x);
+    }
+
+    Deque &operator=(const Deque &other) {
+        if (this == &other)
+            return *this;
+        clear();
+        for (const T &x : other)
+            push_back(x);
+        return *this;
+    }
+
+    ~Deque() {
+        clear();
+        Allocator<Block *>::deallocate(map_);
+    }
+
+    // ----------------------------
+    // 两端插入 / 删除：O(1)，只在跨块时向池子要 / 还一个块
+    // ----------------------------
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+    void push_front(const T &value) { emplace_front(value); }
+    void push_front(T &&value) { emplace_front(std::move(value)); }
+
+    template<typename... Args>
+    T &emplace_back(Args &&... args) {
+        const uint64_t p = end_;
+        const bool fresh = empty() || block_of(p) != block_of(p - 1);
+        if (fresh)
+            attach(block_of(p));
+        T *slot = at_pos(p);
+        try {
+            Allocator<T>::construct(slot, std::forward<Args>(args)...);
+        } catch (...) {
+            if (fresh)
+                detach(block_of(p));
+            throw;
+        }
+        ++end_;
+        return *slot;
+    }
+
+    template<typename... Args>
+    T &emplace_front(Args &&... args) {
+        const uint64_t p = begin_ - 1;
+        const bool fresh = empty() || block_of(p) != block_of(begin_);
+        if (fresh)
+            attach(block_of(p));
+        T *slot = at_pos(p);
+        try {
+            Allocator<T>::construct(slot, std::forward<Args>(args)...);
+        } catch (...) {
+            if (fresh)
+                detach(block_of(p));
+            throw;
+        }
+        begin_ = p;
+        return *slot;
+    }
+
+    void pop_back() {
+        if (empty())
+            throw std::out_of_range("deque empty");
+        const uint64_t p = --end_;
+        Allocator<T>::destroy(at_pos(p));
+        if (empty() || block_of(p) != block_of(p - 1))
+            detach(block_of(p));
+        if (empty())
+            begin_ = end_ = kOrigin;
+    }
+
+    void pop_front() {
+        if (empty())
+            throw std::out_of_range("deque empty");
+        const uint64_t p = begin_++;
+        Allocator<T>::destroy(at_pos(p));
+        if (empty() || block_of(p) != block_of(p + 1))
+            detach(block_of(p));
+        if (empty())
+            begin_ = end_ = kOrigin;
+    }
+
+    void clear() {
+        while (!empty())
+            pop_back();
+    }
+
+    // ----------------------------
+    // 访问
+    // ----------------------------
+    T &front() {
+        if (empty())
+            throw std::runtime_error("deque empty");
+        return *at_pos(begin_);
+    }
+
+    T &back() {
+        if (empty())
+            throw std::runtime_error("deque empty");
+        return *at_pos(end_ - 1);
+    }
+
+    T &operator[](const size_t index) { return *at_pos(begin_ + index); }
+    const T &operator[](const size_t index) const { return *at_pos(begin_ + index); }
+
+    T &at(const size_t index) {
+        if (index >= size())
+            throw std::out_of_range("index out of range");
+        return (*this)[index];
+    }
+
+    [[nodiscard]] bool empty() const { return begin_ == end_; }
+    [[nodiscard]] size_t size() const { return end_ - begin_; }
+    [[nodiscard]] size_t block_count() const { return liveBlocks_; }
+    [[nodiscard]] static constexpr size_t block_size() { return BlockSize; }
+    [[nodiscard]] const BlockPool &pool() const { return *pool_; }
+
+    iterator begin() { return iterator(this, begin_); }
+    iterator end() { return iterator(this, end_); }
+    const_iterator begin() const { return const_iterator(this, begin_); }
+    const_iterator end() const { return const_iterator(this, end_); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    // ----------------------------
+    // 随机访问迭代器：{队列, 绝对位置}，解引用时经 map 找到块
+    // ----------------------------
+    template<bool Const>
+    class Iter {
+        using Owner = std::conditional_t<Const, const Deque, Deque>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T *, T *>;
+        using reference = std::conditional_t<Const, const T &, T &>;
+
+        Iter() = default;
+
+        Iter(Owner *owner, const uint64_t pos) : owner_(owner), pos_(pos) {
+        }
+
+        // iterator -> const_iterator
+        template<bool C> requires (Const && !C)
+        Iter(const Iter<C> &other) : owner_(other.owner_), pos_(other.pos_) {
+        }
+
+        reference operator*() const { return *owner_->at_pos(pos_); }
+        pointer operator->() const { return owner_->at_pos(pos_); }
+        reference operator[](const difference_type n) const { return *owner_->at_pos(pos_ + n); }
+
+        Iter &operator++() {
+            ++pos_;
+            return *this;
+        }
+
+        Iter operator++(int) {
+            Iter old = *this;
+            ++pos_;
+            return old;
+        }
+
+        Iter &operator--() {
+            --pos_;
+            return *this;
+        }
+
+        Iter operator--(int) {
+            Iter old = *this;
+            --pos_;
+            return old;
+        }
+
+        Iter &operator+=(const difference_type n) {
+            pos_ += n;
+            return *this;
+        }
+
+        Iter &operator-=(const difference_type n) {
+            pos_ -= n;
+            return *this;
+        }
+
+        friend Iter operator+(Iter it, const difference_type n) { return it += n; }
+        friend Iter operator+(const difference_type n, Iter it) { return it += n; }
+        friend Iter operator-(Iter it, const difference_type n) { return it -= n; }
+
+        difference_type operator-(const Iter &other) const {
+            return static_cast<difference_type>(pos_ - other.pos_);
+        }
+
+        bool operator==(const Iter &other) const { return pos_ == other.pos_; }
+        std::strong_ordering operator<=>(const Iter &other) const { return pos_ <=> other.pos_; }
+
+    private:
+        friend class Iter<true>;
+        Owner *owner_ = nullptr;
+        uint64_t pos_ = 0;
+    };
+
+private:
+    static constexpr int kShift = std::countr_zero(BlockSize);
+    static constexpr uint64_t kMask = BlockSize - 1;
+    static constexpr uint64_t kOrigin = uint64_t{1} << 62; // 两个方向都有足够的余量，是 BlockSize 的倍数
+
+    BlockPool ownPool_{1, 64};
+    BlockPool *pool_;
+    Block **map_ = nullptr; // map_[i] 对应绝对块号 mapBase_ + i；不在用的位置为 nullptr
+    uint64_t mapBase_ = 0;
+    size_t mapCap_ = 0;
+    size_t liveBlocks_ = 0;
+    uint64_t begin_ = kOrigin; // 第一个元素的绝对位置
+    uint64_t end_ = kOrigin; // 最后一个元素的下一个位置
+
+    static uint64_t block_of(const uint64_t pos) { return pos >> kShift; }
+
+    T *at_pos(const uint64_t pos) const {
+        Block *b = map_[block_of(pos) - mapBase_];
+        return reinterpret_cast<T *>(b->storage) + (pos & kMask);
+    }
+
+    // 从池里取一个块挂到 map 上；map 放不下就换一张更大的（只搬指针，元素不动）
+    void attach(const uint64_t block) {
+        if (map_ == nullptr || block < mapBase_ || block >= mapBase_ + mapCap_)
+            grow_map(block);
+        map_[block - mapBase_] = pool_->create();
+        ++liveBlocks_;
+    }
+
+    void detach(const uint64_t block) {
+        Block *&slot = map_[block - mapBase_];
+        pool_->destroy(slot);
+        slot = nullptr;
+        --liveBlocks_;
+    }
+
+    // 在用的块（以及即将加入的 block）放在新 map 的中间，两端留出同样的余量。
+    // 只占一半以内时大小不变、只是重新居中（FIFO 队列会一直向一个方向漂移，不能每次都翻倍），否则翻倍
+    void grow_map(const uint64_t block) {
+        uint64_t lo = block, hi = block;
+        if (liveBlocks_ > 0) {
+            lo = std::min(lo, block_of(begin_));
+            hi = std::max(hi, block_of(end_ - 1));
+        }
+        const size_t used = hi - lo + 1;
+        const size_t newCap = used * 2 <= mapCap_ ? mapCap_ : std::max<size_t>({8, mapCap_ * 2, used * 2});
+        const uint64_t newBase = lo - (newCap - used) / 2;
+
+        Block **fresh = Allocator<Block *>::allocate(newCap);
+        std::fill(fresh, fresh + newCap, nullptr);
+        if (liveBlocks_ > 0) {
+            for (uint64_t b = block_of(begin_); b <= block_of(end_ - 1); ++b)
+                fresh[b - newBase] = map_[b - mapBase_];
+        }
+        Allocator<Block *>::deallocate(map_);
+        map_ = fresh;
+        mapBase_ = newBase;
+        mapCap_ = newCap;
+    }
+};
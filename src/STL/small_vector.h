@@ -0,0 +1,395 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "templates_vector.h"
+
+// ======================================================
+// SmallVector<T, N>：带内联存储的 Vector
+// 前 N 个元素放在对象内部的缓冲区里，不碰堆；超过 N 才向 Alloc 申请堆内存，之后和 Vector 一样 2 倍扩容。
+// 大多数请求级的小列表（路径分段、查询参数、头部字段）都不超过 8 个，
+// 用 SmallVector<T, 8> 就完全没有堆分配；而 Vector 哪怕一直是空的，构造时也要 malloc 一次。
+// 接口与 Vector 相同（包括 reserve / shrink_to_fit / erase_if / 区间 insert / insert_if）；
+// 另外 is_inline() 表示当前是否还在用内联缓冲区，并且可以移动：
+// 堆上的缓冲区直接接管，内联缓冲区里的元素只能逐个移动（O(N)，这是内联存储的固有代价）。
+// shrink_to_fit 在元素个数不超过 N 时会搬回内联缓冲区、释放堆内存。
+// 代价：对象本身变大（多了 N 个元素的空间），适合放在栈上或短生命周期的结构里。
+// ======================================================
+template<typename T, size_t N, typename Alloc = Allocator<T> >
+class SmallVector {
+    static_assert(N > 0, "SmallVector needs at least one inline element");
+
+public:
+    SmallVector() : SmallVector(Alloc()) {
+    }
+
+    explicit SmallVector(const Alloc &alloc)
+        : first_(inline_data()), last_(first_), end_(first_ + N), allocator_(alloc) {
+    }
+
+    ~SmallVector() {
+        clear();
+        release();
+    }
+
+    // ----------------------------
+    // 拷贝构造：放得下就用内联缓冲区
+    // ----------------------------
+    SmallVector(const SmallVector &other) : SmallVector(other.allocator_) {
+        copy_from(other);
+    }
+
+    SmallVector &operator=(const SmallVector &other) {
+        if (this == &other)
+            return *this;
+
+        clear();
+        release();
+        copy_from(other);
+        return *this;
+    }
+
+    // ----------------------------
+    // 移动构造 / 移动赋值：对方在堆上就直接接管那块内存，在内联缓冲区里就逐个移动元素；
+    // 之后对方回到空的内联状态。移动赋值连同配置器一起接管（接管的堆内存要用原来的配置器释放）
+    // ----------------------------
+    SmallVector(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : SmallVector(other.allocator_) {
+        take_from(other);
+    }
+
+    SmallVector &operator=(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this == &other)
+            return *this;
+
+        clear();
+        release();
+        allocator_ = other.allocator_;
+        take_from(other);
+        return *this;
+    }
+
+    void push_back(const T &value) {
+        emplace_back(value);
+    }
+
+    void push_back(T &&value) {
+        emplace_back(std::move(value));
+    }
+
+    template<typename... Args>
+    T &emplace_back(Args &&... args) {
+        if (full())
+            return expand(std::forward<Args>(args)...);
+
+        allocator_.construct(last_, std::forward<Args>(args)...);
+        return *last_++;
+    }
+
+    void pop_back() {
+        if (empty())
+            throw std::out_of_range("vector empty");
+
+        --last_;
+        allocator_.destroy(last_);
+    }
+
+    const T &back() const {
+        if (empty())
+            throw std::runtime_error("vector empty");
+        return *(last_ - 1);
+    }
+
+    // 析构所有元素，保留容量
+    void clear() {
+        for (T *p = first_; p != last_; ++p)
+            allocator_.destroy(p);
+        last_ = first_;
+    }
+
+    // 状态查询函数
+    bool empty() const { return first_ == last_; }
+    bool full() const { return last_ == end_; }
+    [[nodiscard]] size_t size() const { return last_ - first_; }
+    [[nodiscard]] size_t capacity() const { return end_ - first_; }
+    [[nodiscard]] bool is_inline() const { return first_ == inline_data(); }
+
+    T &operator[](int index) {
+        if (index < 0 || index >= size()) {
+            throw std::out_of_range("index out of range");
+        }
+        return first_[index];
+    }
+
+    const T &operator[](int index) const {
+        if (index < 0 || index >= size()) {
+            throw std::out_of_range("index out of range");
+        }
+        return first_[index];
+    }
+
+    // 随机访问（连续）迭代器，见 contiguous_iterator.h；Iterator 是旧名字
+    using value_type = T;
+    using iterator = ContiguousIterator<T>;
+    using const_iterator = ContiguousIterator<const T>;
+    using Iterator = iterator;
+
+    iterator begin() { return iterator(first_); }
+    iterator end() { return iterator(last_); }
+    const_iterator begin() const { return const_iterator(first_); }
+    const_iterator end() const { return const_iterator(last_); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    T *data() { return first_; }
+    const T *data() const { return first_; }
+
+    // ----------------------------
+    // reserve：容量不足 n 时一次性扩到 n（超过 N，一定在堆上）
+    // shrink_to_fit：把容量缩到元素个数；放得进内联缓冲区就搬回去并释放堆内存
+    // ----------------------------
+    void reserve(const size_t n) {
+        if (n > capacity())
+            reallocate(n);
+    }
+
+    void shrink_to_fit() {
+        if (!is_inline() && capacity() > size())
+            reallocate(size());
+    }
+
+    // ----------------------------
+    // erase_if：删除所有满足 pred 的元素，返回删除的个数（单趟稳定压缩，同 Vector）
+    // ----------------------------
+    template<typename Pred>
+    size_t erase_if(Pred pred) {
+        T *write = first_;
+        for (T *read = first_; read != last_; ++read) {
+            if (pred(*read))
+                continue;
+            if (write != read)
+                *write = std::move(*read);
+            ++write;
+        }
+        const size_t removed = last_ - write;
+        destroy_elements(allocator_, write, last_);
+        last_ = write;
+        return removed;
+    }
+
+    // ----------------------------
+    // insert：在 pos 前插入 [first, last)，返回指向第一个插入元素的迭代器（同 Vector）
+    // 区间不能来自本容器
+    // ----------------------------
+    template<std::forward_iterator It>
+    iterator insert(const_iterator pos, It first, It last) {
+        const size_t idx = pos - cbegin();
+        const auto n = static_cast<size_t>(std::distance(first, last));
+        if (n == 0)
+            return begin() + idx;
+
+        if (size() + n > capacity()) {
+            insert_realloc(idx, first, last, n);
+            return begin() + idx;
+        }
+
+        // 容量够用：尾部整体后移 n 个位置，落在未构造内存上的部分用构造，其余用赋值
+        T *p = first_ + idx;
+        T *oldLast = last_;
+        const size_t after = oldLast - p;
+        if (after > n) {
+            for (T *src = oldLast - n; src != oldLast; ++src, ++last_)
+                allocator_.construct(last_, std::move(*src));
+            std::move_backward(p, oldLast - n, oldLast);
+            std::copy(first, last, p);
+        } else {
+            It mid = std::next(first, static_cast<std::ptrdiff_t>(after));
+            for (It it = mid; it != last; ++it, ++last_)
+                allocator_.construct(last_, *it);
+            for (T *src = p; src != oldLast; ++src, ++last_)
+                allocator_.construct(last_, std::move(*src));
+            std::copy(first, mid, p);
+        }
+        return begin() + idx;
+    }
+
+    // ----------------------------
+    // insert_if：在每个满足 pred 的元素前插入 make(该元素)，返回插入的个数（同 Vector）
+    // pred 会对每个元素调用两次，应当是无副作用的
+    // ----------------------------
+    template<typename Pred, typename Make>
+    size_t insert_if(Pred pred, Make make) {
+        const auto k = static_cast<size_t>(std::count_if(first_, last_, pred));
+        if (k == 0)
+            return 0;
+        if (size() + k > capacity())
+            reallocate(std::max(capacity() * 2, size() + k));
+
+        T *oldLast = last_;
+        T *write = last_ + k;
+        auto put = [&](T *dst, auto &&value) {
+            if (dst >= oldLast)
+                allocator_.construct(dst, std::forward<decltype(value)>(value));
+            else
+                *dst = std::forward<decltype(value)>(value);
+        };
+        for (T *read = oldLast; read != first_ && write != read;) {
+            --read;
+            const bool hit = pred(*read);
+            T *moved = --write;
+            put(moved, std::move(*read));
+            if (hit)
+                put(--write, make(*moved));
+        }
+        last_ = oldLast + k;
+        return k;
+    }
+
+private:
+    T *first_; // 起始地址：内联缓冲区或堆
+    T *last_; // 已使用区域的下一个位置
+    T *end_; // 容量终点
+    Alloc allocator_;
+    alignas(T) unsigned char inline_[N * sizeof(T)];
+
+    T *inline_data() { return reinterpret_cast<T *>(inline_); }
+    const T *inline_data() const { return reinterpret_cast<const T *>(inline_); }
+
+    // 归还堆内存（如果有），回到空的内联状态；调用前元素应已析构
+    void release() {
+        if (!is_inline())
+            allocator_.deallocate(first_);
+        first_ = last_ = inline_data();
+        end_ = first_ + N;
+    }
+
+    // 接管 other 的元素；调用前本对象应是空的内联状态
+    void take_from(SmallVector &other) {
+        if (other.is_inline()) {
+            relocate_elements(allocator_, other.first_, other.size(), first_);
+            last_ = first_ + other.size();
+            other.last_ = other.first_;
+        } else {
+            first_ = other.first_;
+            last_ = other.last_;
+            end_ = other.end_;
+            other.first_ = other.last_ = other.inline_data();
+            other.end_ = other.first_ + N;
+        }
+    }
+
+    // ----------------------------
+    // 换一块容量为 newCap（不小于 size()）的内存并搬过去：
+    // newCap 不超过 N 时回到内联缓冲区（只有 shrink_to_fit 会这样调用，此时一定在堆上），否则在堆上
+    // ----------------------------
+    void reallocate(const size_t newCap) {
+        const size_t len = size();
+        const bool toInline = newCap <= N;
+        T *newData = toInline ? inline_data() : allocator_.allocate(newCap);
+        try {
+            relocate_elements(allocator_, first_, len, newData);
+        } catch (...) {
+            if (!toInline)
+                allocator_.deallocate(newData);
+            throw;
+        }
+        if (!is_inline())
+            allocator_.deallocate(first_);
+        first_ = newData;
+        last_ = newData + len;
+        end_ = newData + (toInline ? N : newCap);
+    }
+
+    // ----------------------------
+    // 容量不够的区间插入：新内存（一定在堆上）里先构造插入的元素，再把 pos 前后两段旧元素分别搬过去
+    // ----------------------------
+    template<typename It>
+    void insert_realloc(const size_t idx, It first, It last, const size_t n) {
+        const size_t len = size();
+        const size_t newCap = std::max(capacity() * 2, len + n);
+        T *newData = allocator_.allocate(newCap);
+
+        T *cur = newData + idx;
+        try {
+            for (; first != last; ++first, ++cur)
+                allocator_.construct(cur, *first);
+        } catch (...) {
+            destroy_elements(allocator_, newData + idx, cur);
+            allocator_.deallocate(newData);
+            throw;
+        }
+        try {
+            transfer_elements(allocator_, first_, idx, newData);
+        } catch (...) {
+            destroy_elements(allocator_, newData + idx, cur);
+            allocator_.deallocate(newData);
+            throw;
+        }
+        try {
+            transfer_elements(allocator_, first_ + idx, len - idx, cur);
+        } catch (...) {
+            destroy_elements(allocator_, newData, cur);
+            allocator_.deallocate(newData);
+            throw;
+        }
+
+        destroy_elements(allocator_, first_, last_);
+        if (!is_inline())
+            allocator_.deallocate(first_);
+        first_ = newData;
+        last_ = newData + len + n;
+        end_ = newData + newCap;
+    }
+
+    void copy_from(const SmallVector &other) {
+        const size_t len = other.size();
+        if (len > N) {
+            first_ = last_ = allocator_.allocate(len);
+            end_ = first_ + len;
+        }
+        for (size_t i = 0; i < len; ++i) {
+            allocator_.construct(last_, other.first_[i]);
+            ++last_;
+        }
+    }
+
+    // ----------------------------
+    // 扩容：2 倍扩容，新内存总在堆上；第一次扩容就是从内联缓冲区"溢出"到堆
+    // 和 Vector 一样先构造新元素，再搬旧元素
+    // ----------------------------
+    template<typename... Args>
+    T &expand(Args &&... args) {
+        const size_t newCap = capacity() * 2;
+        const size_t len = size();
+
+        T *newData = allocator_.allocate(newCap);
+
+        try {
+            allocator_.construct(newData + len, std::forward<Args>(args)...);
+        } catch (...) {
+            allocator_.deallocate(newData);
+            throw;
+        }
+
+        try {
+            relocate_elements(allocator_, first_, len, newData);
+        } catch (...) {
+            allocator_.destroy(newData + len);
+            allocator_.deallocate(newData);
+            throw;
+        }
+
+        if (!is_inline())
+            allocator_.deallocate(first_);
+
+        first_ = newData;
+        last_ = newData + len + 1;
+        end_ = newData + newCap;
+        return newData[len];
+    }
+};
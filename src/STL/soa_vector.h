@@ -0,0 +1,277 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "aligned_allocator.h"
+
+// ======================================================
+// SoAVector<Fields...>：结构体数组（AoS）改成数组结构体（SoA）
+// m_sizeof.cpp 里的 AlignedStruct {char a; int b; short c;} 因为填充占 12 字节，
+// 而真正有用的只有 7 字节；按某一个字段扫描时，每读 4 字节有效数据要带上 8 字节别的东西。
+// SoAVector<char, int, short> 把每个字段存成一列独立的连续数组（64 字节对齐）：
+//   - column<I>() 返回第 I 列的 std::span，可以直接交给 simd::sum / count_if 等内核，
+//     或者写普通循环让编译器自动向量化
+//   - v[i] 返回行代理 SoARow，get<I>() 或结构化绑定 auto [a, b, c] = v[i] 拿到各字段的引用
+//   - 迭代器逐行产生行代理，支持范围 for
+// 字段要求平凡可拷贝（记录类型的常见情况），扩容时每列一次 memcpy。
+// ======================================================
+// 行代理：指向第 index 行的各个字段；Const 为 true 时字段只读
+template<bool Const, typename... Fields>
+class SoARow {
+public:
+    using Columns = std::tuple<Fields *...>;
+
+    SoARow(const Columns *columns, const size_t index) : columns_(columns), index_(index) {
+    }
+
+    template<size_t I>
+    decltype(auto) get() const {
+        auto &field = std::get<I>(*columns_)[index_];
+        if constexpr (Const)
+            return static_cast<const std::remove_reference_t<decltype(field)> &>(field);
+        else
+            return (field);
+    }
+
+    // 整行拷贝成 tuple
+    operator std::tuple<Fields...>() const {
+        return std::apply([this](auto *... cols) { return std::tuple<Fields...>(cols[index_]...); }, *columns_);
+    }
+
+    // 整行赋值
+    const SoARow &operator=(const std::tuple<Fields...> &row) const requires (!Const) {
+        assign(row, std::index_sequence_for<Fields...>());
+        return *this;
+    }
+
+private:
+    template<size_t... I>
+    void assign(const std::tuple<Fields...> &row, std::index_sequence<I...>) const {
+        ((std::get<I>(*columns_)[index_] = std::get<I>(row)), ...);
+    }
+
+    const Columns *columns_;
+    size_t index_;
+};
+
+// 逐行迭代器：解引用得到行代理（与 std::views::zip 一样，引用类型是代理而不是真正的引用，
+// 所以只标成 input_iterator_tag，但支持随机访问的全部操作）
+template<bool Const, typename... Fields>
+class SoAIterator {
+public:
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::tuple<Fields...>;
+    using difference_type = std::ptrdiff_t;
+    using reference = SoARow<Const, Fields...>;
+
+    SoAIterator() = default;
+
+    SoAIterator(const std::tuple<Fields *...> *columns, const size_t index) : columns_(columns), index_(index) {
+    }
+
+    reference operator*() const { return reference(columns_, index_); }
+    reference operator[](const difference_type n) const { return reference(columns_, index_ + n); }
+
+    SoAIterator &operator++() {
+        ++index_;
+        return *this;
+    }
+
+    SoAIterator operator++(int) {
+        SoAIterator old = *this;
+        ++index_;
+        return old;
+    }
+
+    SoAIterator &operator--() {
+        --index_;
+        return *this;
+    }
+
+    SoAIterator operator--(int) {
+        SoAIterator old = *this;
+        --index_;
+        return old;
+    }
+
+    SoAIterator &operator+=(const difference_type n) {
+        index_ += n;
+        return *this;
+    }
+
+    SoAIterator &operator-=(const difference_type n) {
+        index_ -= n;
+        return *this;
+    }
+
+    friend SoAIterator operator+(SoAIterator it, const difference_type n) { return it += n; }
+    friend SoAIterator operator+(const difference_type n, SoAIterator it) { return it += n; }
+    friend SoAIterator operator-(SoAIterator it, const difference_type n) { return it -= n; }
+
+    difference_type operator-(const SoAIterator &other) const {
+        return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+    }
+
+    bool operator==(const SoAIterator &other) const { return index_ == other.index_; }
+    std::strong_ordering operator<=>(const SoAIterator &other) const { return index_ <=> other.index_; }
+
+private:
+    const std::tuple<Fields *...> *columns_ = nullptr;
+    size_t index_ = 0;
+};
+
+template<typename... Fields>
+class SoAVector {
+    static_assert(sizeof...(Fields) > 0, "SoAVector needs at least one field");
+    static_assert((std::is_trivially_copyable_v<Fields> && ...), "SoAVector fields must be trivially copyable");
+
+public:
+    template<size_t I>
+    using field_type = std::tuple_element_t<I, std::tuple<Fields...> >;
+
+    using value_type = std::tuple<Fields...>;
+    using reference = SoARow<false, Fields...>;
+    using const_reference = SoARow<true, Fields...>;
+    using iterator = SoAIterator<false, Fields...>;
+    using const_iterator = SoAIterator<true, Fields...>;
+
+    explicit SoAVector(const size_t cap = 16) {
+        allocate_columns(columns_, cap);
+        cap_ = cap;
+    }
+
+    ~SoAVector() {
+        free_columns(columns_);
+    }
+
+    SoAVector(const SoAVector &other) : SoAVector(other.size_) {
+        copy_columns(other.columns_, columns_, other.size_);
+        size_ = other.size_;
+    }
+
+    SoAVector &operator=(const SoAVector &other) {
+        if (this == &other)
+            return *this;
+
+        clear();
+        reserve(other.size_);
+        copy_columns(other.columns_, columns_, other.size_);
+        size_ = other.size_;
+        return *this;
+    }
+
+    // 追加一行：push_back(a, b, c) 或 push_back(tuple)
+    // 字段按值传入：参数可能来自本容器（v.push_back(v[0])），扩容后旧列已经释放
+    void push_back(const Fields... values) {
+        if (size_ == cap_)
+            reallocate(std::max<size_t>(1, cap_ * 2));
+        size_t i = size_++;
+        std::apply([&](Fields *... cols) { ((cols[i] = values), ...); }, columns_);
+    }
+
+    void push_back(const value_type &row) {
+        std::apply([this](const Fields &... values) { push_back(values...); }, row);
+    }
+
+    void pop_back() {
+        if (empty())
+            throw std::out_of_range("vector empty");
+        --size_;
+    }
+
+    void clear() { size_ = 0; }
+
+    void reserve(const size_t n) {
+        if (n > cap_)
+            reallocate(n);
+    }
+
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+    [[nodiscard]] size_t size() const { return size_; }
+    [[nodiscard]] size_t capacity() const { return cap_; }
+
+    // 行访问
+    reference operator[](const size_t index) { return reference(&columns_, index); }
+    const_reference operator[](const size_t index) const { return const_reference(&columns_, index); }
+
+    reference at(const size_t index) {
+        if (index >= size_)
+            throw std::out_of_range("index out of range");
+        return (*this)[index];
+    }
+
+    // 列访问：第 I 个字段的连续数组
+    template<size_t I>
+    std::span<field_type<I> > column() { return {std::get<I>(columns_), size_}; }
+
+    template<size_t I>
+    std::span<const field_type<I> > column() const { return {std::get<I>(columns_), size_}; }
+
+    iterator begin() { return iterator(&columns_, 0); }
+    iterator end() { return iterator(&columns_, size_); }
+    const_iterator begin() const { return const_iterator(&columns_, 0); }
+    const_iterator end() const { return const_iterator(&columns_, size_); }
+
+private:
+    using Columns = std::tuple<Fields *...>;
+
+    Columns columns_{};
+    size_t size_ = 0;
+    size_t cap_ = 0;
+
+    // cols 必须全是 nullptr；中途失败时把已申请的列还回去
+    static void allocate_columns(Columns &cols, const size_t cap) {
+        try {
+            std::apply([cap](Fields *&... c) { ((c = AlignedAllocator<Fields>::allocate(cap)), ...); }, cols);
+        } catch (...) {
+            free_columns(cols);
+            cols = Columns{};
+            throw;
+        }
+    }
+
+    static void free_columns(Columns &cols) {
+        std::apply([](Fields *... c) { (AlignedAllocator<Fields>::deallocate(c), ...); }, cols);
+    }
+
+    template<size_t... I>
+    static void copy_columns(const Columns &from, Columns &to, const size_t n, std::index_sequence<I...>) {
+        (std::memcpy(static_cast<void *>(std::get<I>(to)), std::get<I>(from), n * sizeof(Fields)), ...);
+    }
+
+    static void copy_columns(const Columns &from, Columns &to, const size_t n) {
+        if (n > 0)
+            copy_columns(from, to, n, std::index_sequence_for<Fields...>());
+    }
+
+    // 每一列各换一块新内存，一次 memcpy 搬过去
+    void reallocate(const size_t newCap) {
+        Columns fresh{};
+        allocate_columns(fresh, newCap);
+        copy_columns(columns_, fresh, size_);
+        free_columns(columns_);
+        columns_ = fresh;
+        cap_ = newCap;
+    }
+};
+
+// 行代理支持结构化绑定：auto [a, b, c] = v[i];
+template<bool Const, typename... Fields>
+struct std::tuple_size<SoARow<Const, Fields...> > : std::integral_constant<size_t, sizeof...(Fields)> {
+};
+
+template<size_t I, bool Const, typename... Fields>
+struct std::tuple_element<I, SoARow<Const, Fields...> > {
+    using field = std::tuple_element_t<I, std::tuple<Fields...> >;
+    using type = std::conditional_t<Const, const field &, field &>;
+};
@@ -0,0 +1,445 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "contiguous_iterator.h"
+
+// ======================================================
+// 自定义空间配置器（简化版）
+// 负责：开辟内存 / 释放内存 / 构造对象 / 析构对象
+// ======================================================
+template<typename T>
+struct Allocator {
+    // 分配内存（仅分配，不构造）
+    static T *allocate(const size_t n) {
+        return static_cast<T *>(malloc(sizeof(T) * n));
+    }
+
+    // 释放内存（不析构）
+    static void deallocate(T *ptr) {
+        free(ptr);
+    }
+
+    // 构造对象（placement new）,在指定的内存位置（ptr）上构造一个类型为 T 的对象，参数原样转发给 T 的构造函数。
+    template<typename... Args>
+    static void construct(T *ptr, Args &&... args) {
+        new(ptr) T(std::forward<Args>(args)...);
+    }
+
+    // 调用对象的析构函数
+    static void destroy(T *ptr) {
+        ptr->~T();
+    }
+};
+
+
+// ======================================================
+// 把 len 个旧元素搬到新内存（Vector / SmallVector 扩容、插入共用）
+//  - 平凡可拷贝的类型（int、POD 结构体）：一次 memcpy
+//  - 移动构造是 noexcept 的（std::string 等）：逐个移动，不再深拷贝
+//  - 否则逐个拷贝：拷贝中途抛异常时析构已构造的部分，旧数据完好无损（强异常保证，同 std::vector）
+// transfer_elements 只构造新元素；relocate_elements 再析构旧元素
+// ======================================================
+template<typename T, typename Alloc>
+void transfer_elements(Alloc &allocator, T *src, const size_t len, T *dest) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        if (len > 0)
+            std::memcpy(static_cast<void *>(dest), static_cast<const void *>(src), len * sizeof(T));
+    } else {
+        size_t i = 0;
+        try {
+            for (; i < len; ++i)
+                allocator.construct(dest + i, std::move_if_noexcept(src[i]));
+        } catch (...) {
+            while (i > 0)
+                allocator.destroy(dest + --i);
+            throw;
+        }
+    }
+}
+
+template<typename T, typename Alloc>
+void destroy_elements(Alloc &allocator, T *first, T *last) {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        for (; first != last; ++first)
+            allocator.destroy(first);
+    }
+}
+
+template<typename T, typename Alloc>
+void relocate_elements(Alloc &allocator, T *src, const size_t len, T *dest) {
+    transfer_elements(allocator, src, len, dest);
+    destroy_elements(allocator, src, src + len);
+}
+
+
+// ======================================================
+// 自定义 Vector 容器
+// 模拟 std::vector（简化版）
+// ======================================================
+template<typename T, typename Alloc = Allocator<T> >
+class Vector {
+public:
+    // ----------------------------
+    // 构造函数：仅开辟空间，不构造对象
+    // ----------------------------
+    explicit Vector(size_t cap = 10)
+        : Vector(cap, Alloc()) {
+    }
+
+    // 使用有状态的配置器（例如指向某个 Arena 的 ArenaAllocator）
+    Vector(size_t cap, const Alloc &alloc)
+        : first_(nullptr), last_(nullptr), end_(nullptr), allocator_(alloc) {
+        first_ = allocator_.allocate(cap);
+        last_ = first_; // 当前没有元素
+        end_ = first_ + cap; // 容量终点
+    }
+
+    // ----------------------------
+    // 析构函数：先析构对象，再释放内存
+    // ----------------------------
+    ~Vector() {
+        for (T *p = first_; p != last_; ++p)
+            allocator_.destroy(p);
+
+        allocator_.deallocate(first_);
+    }
+
+    // ----------------------------
+    // 拷贝构造（深拷贝）
+    // ----------------------------
+    Vector(const Vector &other) : allocator_(other.allocator_) {
+        size_t cap = other.capacity();
+        size_t len = other.size();
+
+        first_ = allocator_.allocate(cap);
+
+        // 构造每个有效元素
+        for (size_t i = 0; i < len; ++i)
+            allocator_.construct(first_ + i, other.first_[i]);
+
+        last_ = first_ + len;
+        end_ = first_ + cap;
+    }
+
+    // ----------------------------
+    // 赋值运算符（深拷贝 + 自赋值检查）
+    // ----------------------------
+    Vector &operator=(const Vector &other) {
+        if (this == &other)
+            return *this;
+
+        // 先析构旧元素
+        for (T *p = first_; p != last_; ++p)
+            allocator_.destroy(p);
+
+        // 释放旧内存
+        allocator_.deallocate(first_);
+
+        // 重新分配
+        size_t cap = other.capacity();
+        size_t len = other.size();
+        first_ = allocator_.allocate(cap);
+
+        // 拷贝对象
+        for (size_t i = 0; i < len; ++i)
+            allocator_.construct(first_ + i, other.first_[i]);
+
+        last_ = first_ + len;
+        end_ = first_ + cap;
+
+        return *this;
+    }
+
+    // ----------------------------
+    // push_back：构造新对象（左值拷贝，右值移动）
+    // ----------------------------
+    void push_back(const T &value) {
+        emplace_back(value);
+    }
+
+    void push_back(T &&value) {
+        emplace_back(std::move(value));
+    }
+
+    // ----------------------------
+    // emplace_back：用参数在末尾原地构造
+    // ----------------------------
+    template<typename... Args>
+    T &emplace_back(Args &&... args) {
+        if (full())
+            return expand(std::forward<Args>(args)...);
+
+        allocator_.construct(last_, std::forward<Args>(args)...);
+        return *last_++;
+    }
+
+    // ----------------------------
+    // pop_back：先析构对象
+    // ----------------------------
+    void pop_back() {
+        if (empty())
+            throw std::out_of_range("vector empty");
+
+        --last_;
+        allocator_.destroy(last_);
+    }
+
+    // ----------------------------
+    // back：访问最后一个元素
+    // ----------------------------
+    const T &back() const {
+        if (empty())
+            throw std::runtime_error("vector empty");
+        return *(last_ - 1);
+    }
+
+    // 状态查询函数
+    bool empty() const { return first_ == last_; }
+    bool full() const { return last_ == end_; }
+    [[nodiscard]] size_t size() const { return last_ - first_; }
+    [[nodiscard]] size_t capacity() const { return end_ - first_; }
+    //下标运算符
+    T &operator[](int index) {
+        if (index < 0 || index >= size()) {
+            throw std::out_of_range("index out of range");
+        }
+        return first_[index];
+    }
+
+    const T &operator[](int index) const {
+        if (index < 0 || index >= size()) {
+            throw std::out_of_range("index out of range");
+        }
+        return first_[index];
+    }
+
+    // 随机访问（连续）迭代器，见 contiguous_iterator.h；Iterator 是旧名字
+    using value_type = T;
+    using iterator = ContiguousIterator<T>;
+    using const_iterator = ContiguousIterator<const T>;
+    using Iterator = iterator;
+
+    iterator begin() { return iterator(first_); }
+    iterator end() { return iterator(last_); }
+    const_iterator begin() const { return const_iterator(first_); }
+    const_iterator end() const { return const_iterator(last_); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    T *data() { return first_; }
+    const T *data() const { return first_; }
+
+    // ----------------------------
+    // reserve：容量不足 n 时一次性扩到 n；shrink_to_fit：把容量缩到元素个数
+    // ----------------------------
+    void reserve(const size_t n) {
+        if (n > capacity())
+            reallocate(n);
+    }
+
+    void shrink_to_fit() {
+        if (capacity() > size())
+            reallocate(size());
+    }
+
+    // ----------------------------
+    // erase_if：删除所有满足 pred 的元素，返回删除的个数
+    // 单趟稳定压缩：保留的元素依次移动到写指针处，最后析构尾部——O(n)，
+    // 而循环里逐个 erase(it) 每次都要挪动整个尾部，是 O(n²)
+    // ----------------------------
+    template<typename Pred>
+    size_t erase_if(Pred pred) {
+        T *write = first_;
+        for (T *read = first_; read != last_; ++read) {
+            if (pred(*read))
+                continue;
+            if (write != read)
+                *write = std::move(*read);
+            ++write;
+        }
+        const size_t removed = last_ - write;
+        destroy_elements(allocator_, write, last_);
+        last_ = write;
+        return removed;
+    }
+
+    // ----------------------------
+    // insert：在 pos 前插入 [first, last)，返回指向第一个插入元素的迭代器
+    // 最多一次重新分配、一次挪动尾部（逐个 insert 是 O(n²)）
+    // 区间不能来自本容器
+    // ----------------------------
+    template<std::forward_iterator It>
+    iterator insert(const_iterator pos, It first, It last) {
+        const size_t idx = pos - cbegin();
+        const auto n = static_cast<size_t>(std::distance(first, last));
+        if (n == 0)
+            return begin() + idx;
+
+        if (size() + n > capacity()) {
+            insert_realloc(idx, first, last, n);
+            return begin() + idx;
+        }
+
+        // 容量够用：尾部整体后移 n 个位置，落在未构造内存上的部分用构造，其余用赋值
+        T *p = first_ + idx;
+        T *oldLast = last_;
+        const size_t after = oldLast - p;
+        if (after > n) {
+            for (T *src = oldLast - n; src != oldLast; ++src, ++last_)
+                allocator_.construct(last_, std::move(*src));
+            std::move_backward(p, oldLast - n, oldLast);
+            std::copy(first, last, p);
+        } else {
+            It mid = std::next(first, static_cast<std::ptrdiff_t>(after));
+            for (It it = mid; it != last; ++it, ++last_)
+                allocator_.construct(last_, *it);
+            for (T *src = p; src != oldLast; ++src, ++last_)
+                allocator_.construct(last_, std::move(*src));
+            std::copy(first, mid, p);
+        }
+        return begin() + idx;
+    }
+
+    // ----------------------------
+    // insert_if：在每个满足 pred 的元素前插入 make(该元素)，返回插入的个数
+    // 先数出要插入 k 个，最多重新分配一次；再从尾到头一趟，
+    // 把每个元素直接移到最终位置（向后错开它前面命中的个数），顺手在它前面构造新元素
+    // pred 会对每个元素调用两次，应当是无副作用的
+    // ----------------------------
+    template<typename Pred, typename Make>
+    size_t insert_if(Pred pred, Make make) {
+        const auto k = static_cast<size_t>(std::count_if(first_, last_, pred));
+        if (k == 0)
+            return 0;
+        if (size() + k > capacity())
+            reallocate(std::max(capacity() * 2, size() + k));
+
+        T *oldLast = last_;
+        T *write = last_ + k;
+        // 目标位置在旧的末尾之后是未构造内存，要构造；之前的是已有元素，直接赋值
+        auto put = [&](T *dst, auto &&value) {
+            if (dst >= oldLast)
+                allocator_.construct(dst, std::forward<decltype(value)>(value));
+            else
+                *dst = std::forward<decltype(value)>(value);
+        };
+        for (T *read = oldLast; read != first_ && write != read;) {
+            --read;
+            const bool hit = pred(*read);
+            T *moved = --write;
+            put(moved, std::move(*read));
+            if (hit)
+                put(--write, make(*moved));
+        }
+        last_ = oldLast + k;
+        return k;
+    }
+
+private:
+    T *first_; // 起始地址
+    T *last_; // 已使用区域的下一个位置
+    T *end_; // 容量终点
+    Alloc allocator_;
+
+    // ----------------------------
+    // 换一块容量为 newCap（不小于 size()）的内存，搬过去
+    // ----------------------------
+    void reallocate(const size_t newCap) {
+        const size_t len = size();
+        T *newData = allocator_.allocate(newCap);
+        try {
+            relocate_elements(allocator_, first_, len, newData);
+        } catch (...) {
+            allocator_.deallocate(newData);
+            throw;
+        }
+        allocator_.deallocate(first_);
+        first_ = newData;
+        last_ = newData + len;
+        end_ = newData + newCap;
+    }
+
+    // ----------------------------
+    // 容量不够的区间插入：新内存里先构造插入的元素，再把 pos 前后两段旧元素分别搬过去
+    // ----------------------------
+    template<typename It>
+    void insert_realloc(const size_t idx, It first, It last, const size_t n) {
+        const size_t len = size();
+        const size_t newCap = std::max(capacity() * 2, len + n);
+        T *newData = allocator_.allocate(newCap);
+
+        T *cur = newData + idx;
+        try {
+            for (; first != last; ++first, ++cur)
+                allocator_.construct(cur, *first);
+        } catch (...) {
+            destroy_elements(allocator_, newData + idx, cur);
+            allocator_.deallocate(newData);
+            throw;
+        }
+        try {
+            transfer_elements(allocator_, first_, idx, newData);
+        } catch (...) {
+            destroy_elements(allocator_, newData + idx, cur);
+            allocator_.deallocate(newData);
+            throw;
+        }
+        try {
+            transfer_elements(allocator_, first_ + idx, len - idx, cur);
+        } catch (...) {
+            destroy_elements(allocator_, newData, cur);
+            allocator_.deallocate(newData);
+            throw;
+        }
+
+        destroy_elements(allocator_, first_, last_);
+        allocator_.deallocate(first_);
+        first_ = newData;
+        last_ = newData + len + n;
+        end_ = newData + newCap;
+    }
+
+    // ----------------------------
+    // 扩容：2 倍扩容，并在新内存的末尾构造新元素
+    // 先构造新元素再搬旧元素：参数可能引用着旧元素（v.push_back(v[0])），旧内存此时还有效
+    // ----------------------------
+    template<typename... Args>
+    T &expand(Args &&... args) {
+        const size_t oldCap = capacity();
+        size_t newCap = oldCap == 0 ? 1 : oldCap * 2;
+
+        T *newData = allocator_.allocate(newCap);
+
+        size_t len = size();
+
+        try {
+            allocator_.construct(newData + len, std::forward<Args>(args)...);
+        } catch (...) {
+            allocator_.deallocate(newData);
+            throw;
+        }
+
+        try {
+            relocate_elements(allocator_, first_, len, newData);
+        } catch (...) {
+            allocator_.destroy(newData + len);
+            allocator_.deallocate(newData);
+            throw;
+        }
+
+        allocator_.deallocate(first_);
+
+        // 更新指针
+        first_ = newData;
+        last_ = newData + len + 1;
+        end_ = newData + newCap;
+        return newData[len];
+    }
+};
@@ -0,0 +1,283 @@
+#pragma once
+
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+/*
+CPU 拓扑 / 线程绑核 / NUMA 本地内存
+  双路服务器上，std::thread 创建的线程会被调度器在各个核、甚至两个 socket 之间迁移：
+    - 迁移后 L1/L2 缓存全部失效；
+    - 跨 socket 访问内存要走 QPI/UPI，延迟和带宽都明显变差。
+
+  1. CpuTopology::detect() 读取 /sys/devices/system/cpu 与 /sys/devices/system/node，
+     得到每个逻辑 CPU 的 (NUMA 节点, socket, 物理核)；
+  2. plan() 按放置策略给 N 个工作线程分配 CPU：
+       Compact    紧凑：先占满一个节点的物理核，再用超线程，再到下一个节点（共享缓存多）
+       Scatter    分散：在节点之间轮流分配（聚合内存带宽大）
+       SingleNode 只用指定节点上的 CPU（与该节点的内存、网卡放在一起）
+  3. pin_current_thread() 绑核，NumaMemory 按节点分配内存（mbind，失败则退化为首次访问）。
+
+  不依赖 libnuma，直接用 sysfs 和系统调用。
+*/
+
+enum class Placement { None, Compact, Scatter, SingleNode };
+
+inline const char *placement_name(Placement p) {
+  switch (p) {
+  case Placement::None:
+    return "none";
+  case Placement::Compact:
+    return "compact";
+  case Placement::Scatter:
+    return "scatter";
+  case Placement::SingleNode:
+    return "single-node";
+  }
+  return "unknown";
+}
+
+struct CpuInfo {
+  int cpu = 0;     // 逻辑 CPU 编号
+  int node = 0;    // NUMA 节点
+  int package = 0; // 物理 socket
+  int core = 0;    // socket 内的物理核编号
+  int smt = 0;     // 同一物理核上的第几个超线程
+};
+
+class CpuTopology {
+public:
+  // 解析 "0-3,8,10-11" 这种 cpulist 格式
+  static std::vector<int> parse_list(const std::string &text) {
+    std::vector<int> out;
+    std::stringstream ss(text);
+    std::string part;
+    while (std::getline(ss, part, ',')) {
+      if (part.empty() || part == "\n")
+        continue;
+      const auto dash = part.find('-');
+      try {
+        if (dash == std::string::npos) {
+          out.push_back(std::stoi(part));
+        } else {
+          const int lo = std::stoi(part.substr(0, dash));
+          const int hi = std::stoi(part.substr(dash + 1));
+          for (int i = lo; i <= hi; ++i)
+            out.push_back(i);
+        }
+      } catch (const std::exception &) {
+        // 格式不认识就跳过这一段
+      }
+    }
+    return out;
+  }
+
+  static CpuTopology detect() {
+    CpuTopology topo;
+    const std::string base = "/sys/devices/system/cpu/";
+    std::vector<int> online = parse_list(read_file(base + "online"));
+    if (online.empty()) {
+      // 没有 sysfs（容器/非 Linux），退化为单节点
+      const unsigned n = std::max(1U, std::thread::hardware_concurrency());
+      for (unsigned i = 0; i < n; ++i)
+        online.push_back(static_cast<int>(i));
+    }
+
+    // 节点 -> CPU 列表
+    std::map<int, int> nodeOf;
+    for (int node = 0; node < kMaxNodes; ++node) {
+      const std::string list = read_file("/sys/devices/system/node/node" +
+                                         std::to_string(node) + "/cpulist");
+      if (list.empty())
+        continue;
+      for (int cpu : parse_list(list))
+        nodeOf[cpu] = node;
+    }
+
+    std::map<std::pair<int, int>, int> smtCount; // (package, core) -> 已见数量
+    for (int cpu : online) {
+      CpuInfo info;
+      info.cpu = cpu;
+      const std::string topo_dir = base + "cpu" + std::to_string(cpu) + "/topology/";
+      info.package = read_int(topo_dir + "physical_package_id", 0);
+      info.core = read_int(topo_dir + "core_id", cpu);
+      info.node = nodeOf.count(cpu) ? nodeOf[cpu] : 0;
+      info.smt = smtCount[{info.package, info.core}]++;
+      topo.cpus_.push_back(info);
+    }
+    return topo;
+  }
+
+  [[nodiscard]] const std::vector<CpuInfo> &cpus() const { return cpus_; }
+
+  [[nodiscard]] std::vector<int> nodes() const {
+    std::vector<int> out;
+    for (const auto &c : cpus_)
+      if (std::find(out.begin(), out.end(), c.node) == out.end())
+        out.push_back(c.node);
+    std::sort(out.begin(), out.end());
+    return out;
+  }
+
+  [[nodiscard]] int node_of(int cpu) const {
+    for (const auto &c : cpus_)
+      if (c.cpu == cpu)
+        return c.node;
+    return 0;
+  }
+
+  // 给 workers 个线程分配 CPU，返回每个线程应绑定的 CPU（-1 表示不绑定）
+  [[nodiscard]] std::vector<int> plan(Placement policy, size_t workers,
+                                      int node = 0) const {
+    std::vector<int> out(workers, -1);
+    if (policy == Placement::None || cpus_.empty())
+      return out;
+
+    std::vector<CpuInfo> order = cpus_;
+    if (policy == Placement::SingleNode) {
+      order.erase(std::remove_if(order.begin(), order.end(),
+                                 [node](const CpuInfo &c) {
+                                   return c.node != node;
+                                 }),
+                  order.end());
+      if (order.empty())
+        order = cpus_;
+    }
+
+    if (policy == Placement::Scatter) {
+      // 先物理核后超线程；同一层内按 (core, node) 排序，节点之间交替
+      std::sort(order.begin(), order.end(),
+                [](const CpuInfo &a, const CpuInfo &b) {
+                  return std::tie(a.smt, a.core, a.node, a.cpu) <
+                         std::tie(b.smt, b.core, b.node, b.cpu);
+                });
+    } else {
+      // Compact / SingleNode：一个节点的物理核用完，再用它的超线程，再去下一个节点
+      std::sort(order.begin(), order.end(),
+                [](const CpuInfo &a, const CpuInfo &b) {
+                  return std::tie(a.node, a.smt, a.package, a.core, a.cpu) <
+                         std::tie(b.node, b.smt, b.package, b.core, b.cpu);
+                });
+    }
+    // 线程比 CPU 多时循环复用
+    for (size_t i = 0; i < workers; ++i)
+      out[i] = order[i % order.size()].cpu;
+    return out;
+  }
+
+private:
+  static constexpr int kMaxNodes = 64;
+
+  static std::string read_file(const std::string &path) {
+    std::ifstream in(path);
+    std::string s;
+    std::getline(in, s);
+    return s;
+  }
+
+  static int read_int(const std::string &path, int fallback) {
+    const std::string s = read_file(path);
+    try {
+      return s.empty() ? fallback : std::stoi(s);
+    } catch (const std::exception &) {
+      return fallback;
+    }
+  }
+
+  std::vector<CpuInfo> cpus_;
+};
+
+// 把当前线程绑定到一个 CPU，成功返回 true
+inline bool pin_current_thread(int cpu) {
+  if (cpu < 0 || cpu >= CPU_SETSIZE)
+    return false;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+// 当前线程正在哪个 CPU 上运行
+inline int current_cpu() { return sched_getcpu(); }
+
+/*
+NUMA 本地内存
+  用 mmap 拿到匿名内存后，通过 mbind 把它绑定到指定节点；
+  内核不支持或没有权限时退化为"首次访问"策略：由绑好核的工作线程
+  自己把每一页写一遍，默认策略下页面就会分配在该线程所在的节点上。
+*/
+class NumaMemory {
+public:
+  NumaMemory() = default;
+
+  // node < 0 表示"当前线程所在节点"（首次访问）
+  NumaMemory(size_t bytes, int node) : size_(bytes) {
+    void *p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED)
+      throw std::bad_alloc();
+    data_ = p;
+    if (node >= 0 && node < 64) {
+      const unsigned long mask = 1UL << node;
+      bound_ = syscall(SYS_mbind, data_, size_, MPOL_BIND, &mask,
+                       sizeof(mask) * 8, MPOL_MF_MOVE) == 0;
+    }
+    // 首次访问：在调用线程上把每一页都写一遍，真正分配物理页
+    const long page = sysconf(_SC_PAGESIZE);
+    for (size_t off = 0; off < size_; off += static_cast<size_t>(page))
+      static_cast<char *>(data_)[off] = 0;
+  }
+
+  ~NumaMemory() {
+    if (data_ != nullptr)
+      munmap(data_, size_);
+  }
+
+  NumaMemory(NumaMemory &&other) noexcept
+      : data_(other.data_), size_(other.size_), bound_(other.bound_) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+  }
+
+  NumaMemory &operator=(NumaMemory &&other) noexcept {
+    if (this != &other) {
+      if (data_ != nullptr)
+        munmap(data_, size_);
+      data_ = other.data_;
+      size_ = other.size_;
+      bound_ = other.bound_;
+      other.data_ = nullptr;
+      other.size_ = 0;
+    }
+    return *this;
+  }
+
+  NumaMemory(const NumaMemory &) = delete;
+  NumaMemory &operator=(const NumaMemory &) = delete;
+
+  template <typename T> T *as() { return static_cast<T *>(data_); }
+  [[nodiscard]] size_t size() const { return size_; }
+  // 是否通过 mbind 显式绑定成功（否则依赖首次访问）
+  [[nodiscard]] bool bound() const { return bound_; }
+
+private:
+  void *data_ = nullptr;
+  size_t size_ = 0;
+  bool bound_ = false;
+};
@@ -0,0 +1,448 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/*
+无锁数据结构的内存回收
+  无锁队列/链表里，一个线程把节点摘下来之后，别的线程可能还拿着它的指针在读，
+  这时直接 delete 就是 use-after-free。需要"推迟释放，直到确认没人在用"。
+
+一、基于纪元的回收（EBR，Epoch-Based Reclamation）
+  全局纪元 E；线程访问共享结构前"进入"（pin）当前纪元，结束后退出。
+  被摘下的节点放入当前线程的退休列表（按纪元分三个桶）。
+  当所有处于活动状态的线程都已经进入纪元 E 时，全局纪元才能推进到 E+1；
+  于是纪元 E-2 及更早退休的节点，不可能再被任何线程引用，可以释放。
+  优点：读路径只有一次 store + fence，非常便宜；回收是批量、摊销的。
+  缺点：某个线程 pin 住不动（例如被换出），所有线程的回收都会停滞，内存无上界。
+
+二、风险指针（Hazard Pointer）
+  线程在解引用共享指针前，把它登记到自己的风险指针槽位里；
+  退休列表超过阈值时扫描所有线程的槽位，没被登记的节点才释放。
+  每次读都要 store + 校验，比 EBR 贵；但未回收的节点数量有上界
+  （每线程最多 阈值 + 全部槽位数），不会因为某个线程停顿而无限增长。
+*/
+namespace reclaim {
+
+struct Retired {
+  void *ptr;
+  void (*deleter)(void *);
+};
+
+template <typename T> void delete_as(void *p) { delete static_cast<T *>(p); }
+
+// 域析构时，把它从当前线程的记录表里删掉，避免线程退出时访问已销毁的域
+template <typename Handles, typename Domain>
+void forget(Handles &handles, const Domain *domain) {
+  auto &list = handles.list;
+  list.erase(std::remove_if(list.begin(), list.end(),
+                            [domain](const auto &h) {
+                              return h.domain == domain;
+                            }),
+             list.end());
+}
+
+// ======================================================
+// EBR
+// ======================================================
+class EpochDomain {
+  struct ThreadRecord;
+
+public:
+  EpochDomain() = default;
+  EpochDomain(const EpochDomain &) = delete;
+  EpochDomain &operator=(const EpochDomain &) = delete;
+
+  // 销毁时认为已没有线程在访问，直接释放所有剩余节点。
+  // 域必须比访问过它的其他线程活得更久；当前线程的记录会在这里解除关联
+  ~EpochDomain() {
+    if (!Handles::destroyed)
+      forget(handles(), this);
+    ThreadRecord *r = records_.load();
+    while (r != nullptr) {
+      for (auto &bag : r->bags)
+        free_all(bag.items);
+      ThreadRecord *next = r->next;
+      delete r;
+      r = next;
+    }
+    for (auto &o : orphans_)
+      free_all(o.second);
+  }
+
+  static EpochDomain &global() {
+    static EpochDomain domain;
+    return domain;
+  }
+
+  // RAII：作用域内的共享指针都是安全可读的；支持嵌套
+  class Guard {
+  public:
+    explicit Guard(EpochDomain &d) : rec_(d.local()) { d.enter(*rec_); }
+    ~Guard() { leave(); }
+    Guard(const Guard &) = delete;
+    Guard &operator=(const Guard &) = delete;
+
+  private:
+    void leave() {
+      if (--rec_->nest == 0)
+        rec_->epoch.store(kInactive, std::memory_order_release);
+    }
+    ThreadRecord *rec_;
+  };
+
+  Guard pin() { return Guard(*this); }
+
+  // 退休一个已经从共享结构中摘下的对象，等安全时调用 deleter
+  void retire(void *p, void (*deleter)(void *)) {
+    ThreadRecord &r = *local();
+    const uint64_t e = epoch_.load(std::memory_order_acquire);
+    Bag &bag = r.bags[e % 3];
+    if (bag.epoch != e) {
+      // 桶里是 e-3 或更早的节点，全局纪元已前进至少 2，可以释放
+      reclaimed_.fetch_add(bag.items.size(), std::memory_order_relaxed);
+      free_all(bag.items);
+      bag.epoch = e;
+    }
+    bag.items.push_back({p, deleter});
+    retired_.fetch_add(1, std::memory_order_relaxed);
+    if (++r.sinceCollect >= kCollectEvery) {
+      r.sinceCollect = 0;
+      collect(r);
+    }
+  }
+
+  template <typename T> void retire(T *p) { retire(p, &delete_as<T>); }
+
+  // 尝试推进纪元并回收；所有线程都空闲时连续调用可以回收全部节点
+  void collect() { collect(*local()); }
+
+  // 统计：累计退休数 / 累计释放数
+  [[nodiscard]] uint64_t retired() const { return retired_.load(); }
+  [[nodiscard]] uint64_t reclaimed() const { return reclaimed_.load(); }
+  [[nodiscard]] uint64_t epoch() const { return epoch_.load(); }
+
+private:
+  static constexpr uint64_t kInactive = ~uint64_t{0};
+  static constexpr size_t kCollectEvery = 64;
+
+  struct Bag {
+    uint64_t epoch = 0;
+    std::vector<Retired> items;
+  };
+
+  struct alignas(64) ThreadRecord {
+    std::atomic<uint64_t> epoch{kInactive}; // 活动时为进入的纪元
+    std::atomic<bool> inUse{true};
+    unsigned nest = 0;
+    size_t sinceCollect = 0;
+    Bag bags[3];
+    ThreadRecord *next = nullptr;
+  };
+
+  // 每个线程一个记录；线程退出时交还，未释放的节点转为孤儿
+  struct Handle {
+    EpochDomain *domain;
+    ThreadRecord *rec;
+  };
+  struct Handles {
+    std::vector<Handle> list;
+    // 线程退出时先于静态对象析构；之后静态域（如 global()）析构时据此跳过 forget
+    static inline thread_local bool destroyed = false;
+    ~Handles() {
+      for (auto &h : list)
+        h.domain->release(h.rec);
+      destroyed = true;
+    }
+  };
+
+  static Handles &handles() {
+    thread_local Handles h;
+    return h;
+  }
+
+  ThreadRecord *local() {
+    Handles &hs = handles();
+    for (auto &h : hs.list)
+      if (h.domain == this)
+        return h.rec;
+    ThreadRecord *r = acquire();
+    hs.list.push_back({this, r});
+    return r;
+  }
+
+  ThreadRecord *acquire() {
+    // 先复用已退出线程留下的记录
+    for (ThreadRecord *r = records_.load(); r != nullptr; r = r->next) {
+      bool expected = false;
+      if (!r->inUse.load(std::memory_order_relaxed) &&
+          r->inUse.compare_exchange_strong(expected, true))
+        return r;
+    }
+    auto *r = new ThreadRecord();
+    ThreadRecord *head = records_.load();
+    do {
+      r->next = head;
+    } while (!records_.compare_exchange_weak(head, r));
+    return r;
+  }
+
+  void release(ThreadRecord *r) {
+    {
+      std::lock_guard<std::mutex> lock(orphanMtx_);
+      for (auto &bag : r->bags) {
+        if (!bag.items.empty())
+          orphans_.emplace_back(bag.epoch, std::move(bag.items));
+        bag.items.clear();
+      }
+    }
+    r->epoch.store(kInactive);
+    r->nest = 0;
+    r->inUse.store(false, std::memory_order_release);
+  }
+
+  void enter(ThreadRecord &r) {
+    if (r.nest++ > 0)
+      return;
+    // seq_cst：保证"宣布进入纪元"先于之后对共享结构的任何读取
+    r.epoch.store(epoch_.load(std::memory_order_seq_cst),
+                  std::memory_order_seq_cst);
+  }
+
+  bool try_advance() {
+    const uint64_t e = epoch_.load(std::memory_order_seq_cst);
+    for (ThreadRecord *r = records_.load(); r != nullptr; r = r->next) {
+      const uint64_t v = r->epoch.load(std::memory_order_seq_cst);
+      if (v != kInactive && v != e)
+        return false; // 还有线程停在旧纪元
+    }
+    uint64_t expected = e;
+    epoch_.compare_exchange_strong(expected, e + 1);
+    return true;
+  }
+
+  void collect(ThreadRecord &r) {
+    try_advance();
+    const uint64_t e = epoch_.load(std::memory_order_acquire);
+    for (auto &bag : r.bags) {
+      if (!bag.items.empty() && bag.epoch + 2 <= e) {
+        reclaimed_.fetch_add(bag.items.size(), std::memory_order_relaxed);
+        free_all(bag.items);
+      }
+    }
+    // 顺便处理孤儿节点；拿不到锁就下次再说，不在这里排队
+    std::unique_lock<std::mutex> lock(orphanMtx_, std::try_to_lock);
+    if (!lock.owns_lock())
+      return;
+    auto it = std::remove_if(orphans_.begin(), orphans_.end(), [&](auto &o) {
+      if (o.first + 2 > e)
+        return false;
+      reclaimed_.fetch_add(o.second.size(), std::memory_order_relaxed);
+      free_all(o.second);
+      return true;
+    });
+    orphans_.erase(it, orphans_.end());
+  }
+
+  static void free_all(std::vector<Retired> &items) {
+    for (const Retired &r : items)
+      r.deleter(r.ptr);
+    items.clear();
+  }
+
+  std::atomic<uint64_t> epoch_{0};
+  std::atomic<ThreadRecord *> records_{nullptr};
+  std::mutex orphanMtx_;
+  std::vector<std::pair<uint64_t, std::vector<Retired>>> orphans_;
+  std::atomic<uint64_t> retired_{0};
+  std::atomic<uint64_t> reclaimed_{0};
+};
+
+// ======================================================
+// Hazard Pointer
+// ======================================================
+class HazardDomain {
+  struct ThreadRecord;
+
+public:
+  static constexpr size_t kSlots = 4; // 每线程的风险指针槽位数
+
+  HazardDomain() = default;
+  HazardDomain(const HazardDomain &) = delete;
+  HazardDomain &operator=(const HazardDomain &) = delete;
+
+  ~HazardDomain() {
+    if (!Handles::destroyed)
+      forget(handles(), this);
+    ThreadRecord *r = records_.load();
+    while (r != nullptr) {
+      for (const Retired &x : r->retired)
+        x.deleter(x.ptr);
+      ThreadRecord *next = r->next;
+      delete r;
+      r = next;
+    }
+    for (const Retired &x : orphans_)
+      x.deleter(x.ptr);
+  }
+
+  static HazardDomain &global() {
+    static HazardDomain domain;
+    return domain;
+  }
+
+  // 占用当前线程的一个槽位，析构时清空
+  class Holder {
+  public:
+    Holder(HazardDomain &d, size_t slot) : slot_(&d.local()->hazards[slot]) {}
+    ~Holder() { reset(); }
+    Holder(const Holder &) = delete;
+    Holder &operator=(const Holder &) = delete;
+
+    // 读取 src 并登记；登记后再读一次确认没变，保证登记时对象尚未退休
+    template <typename T> T *protect(const std::atomic<T *> &src) {
+      T *p = src.load(std::memory_order_relaxed);
+      while (true) {
+        slot_->store(p, std::memory_order_seq_cst);
+        T *again = src.load(std::memory_order_seq_cst);
+        if (again == p)
+          return p;
+        p = again;
+      }
+    }
+
+    void reset() { slot_->store(nullptr, std::memory_order_release); }
+
+  private:
+    std::atomic<void *> *slot_;
+  };
+
+  void retire(void *p, void (*deleter)(void *)) {
+    ThreadRecord &r = *local();
+    r.retired.push_back({p, deleter});
+    retired_.fetch_add(1, std::memory_order_relaxed);
+    if (r.retired.size() >= threshold())
+      scan(r);
+  }
+
+  template <typename T> void retire(T *p) { retire(p, &delete_as<T>); }
+
+  void collect() { scan(*local()); }
+
+  [[nodiscard]] uint64_t retired() const { return retired_.load(); }
+  [[nodiscard]] uint64_t reclaimed() const { return reclaimed_.load(); }
+
+private:
+  struct alignas(64) ThreadRecord {
+    std::atomic<void *> hazards[kSlots] = {};
+    std::atomic<bool> inUse{true};
+    std::vector<Retired> retired;
+    ThreadRecord *next = nullptr;
+  };
+
+  struct Handle {
+    HazardDomain *domain;
+    ThreadRecord *rec;
+  };
+  struct Handles {
+    std::vector<Handle> list;
+    // 线程退出时先于静态对象析构；之后静态域（如 global()）析构时据此跳过 forget
+    static inline thread_local bool destroyed = false;
+    ~Handles() {
+      for (auto &h : list)
+        h.domain->release(h.rec);
+      destroyed = true;
+    }
+  };
+
+  static Handles &handles() {
+    thread_local Handles h;
+    return h;
+  }
+
+  ThreadRecord *local() {
+    Handles &hs = handles();
+    for (auto &h : hs.list)
+      if (h.domain == this)
+        return h.rec;
+    ThreadRecord *r = acquire();
+    hs.list.push_back({this, r});
+    return r;
+  }
+
+  ThreadRecord *acquire() {
+    for (ThreadRecord *r = records_.load(); r != nullptr; r = r->next) {
+      bool expected = false;
+      if (!r->inUse.load(std::memory_order_relaxed) &&
+          r->inUse.compare_exchange_strong(expected, true))
+        return r;
+    }
+    auto *r = new ThreadRecord();
+    ThreadRecord *head = records_.load();
+    do {
+      r->next = head;
+    } while (!records_.compare_exchange_weak(head, r));
+    recordCount_.fetch_add(1);
+    return r;
+  }
+
+  void release(ThreadRecord *r) {
+    for (auto &h : r->hazards)
+      h.store(nullptr);
+    scan(*r);
+    if (!r->retired.empty()) {
+      std::lock_guard<std::mutex> lock(orphanMtx_);
+      orphans_.insert(orphans_.end(), r->retired.begin(), r->retired.end());
+      r->retired.clear();
+    }
+    r->inUse.store(false, std::memory_order_release);
+  }
+
+  // 阈值与槽位总数成正比，保证每次扫描至少能释放一半，回收摊销为 O(1)
+  size_t threshold() const {
+    return std::max<size_t>(64, 2 * kSlots * recordCount_.load());
+  }
+
+  void scan(ThreadRecord &r) {
+    std::vector<void *> live;
+    for (ThreadRecord *t = records_.load(); t != nullptr; t = t->next)
+      for (auto &h : t->hazards)
+        if (void *p = h.load(std::memory_order_seq_cst))
+          live.push_back(p);
+    std::sort(live.begin(), live.end());
+
+    // 孤儿节点也顺便检查
+    {
+      std::unique_lock<std::mutex> lock(orphanMtx_, std::try_to_lock);
+      if (lock.owns_lock() && !orphans_.empty()) {
+        r.retired.insert(r.retired.end(), orphans_.begin(), orphans_.end());
+        orphans_.clear();
+      }
+    }
+
+    size_t kept = 0;
+    for (const Retired &x : r.retired) {
+      if (std::binary_search(live.begin(), live.end(), x.ptr)) {
+        r.retired[kept++] = x;
+      } else {
+        x.deleter(x.ptr);
+        reclaimed_.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    r.retired.resize(kept);
+  }
+
+  std::atomic<ThreadRecord *> records_{nullptr};
+  std::atomic<size_t> recordCount_{0};
+  std::mutex orphanMtx_;
+  std::vector<Retired> orphans_;
+  std::atomic<uint64_t> retired_{0};
+  std::atomic<uint64_t> reclaimed_{0};
+};
+
+} // namespace reclaim
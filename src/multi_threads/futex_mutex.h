@@ -0,0 +1,288 @@
+#pragma once
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <mutex>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/*
+基于 futex 的 Mutex / CondVar
+  futex（fast userspace mutex）：无竞争时只在用户态做一次原子操作，
+  只有真的要睡眠/唤醒时才进内核（FUTEX_WAIT / FUTEX_WAKE）。
+  std::mutex 在 Linux 上底层也是 futex，这里自己实现是为了能看到竞争情况。
+
+Mutex 状态（Drepper《Futexes Are Tricky》的三态方案）：
+  0 = 未加锁
+  1 = 已加锁，没有等待者      -> unlock 不需要进内核
+  2 = 已加锁，可能有等待者    -> unlock 需要 FUTEX_WAKE
+
+自适应"先自旋再睡眠"：
+  锁通常只被持有很短时间，立即睡眠的代价（两次系统调用 + 上下文切换）
+  比自旋等一会儿更高；自旋上限根据最近几次自旋成功所用的次数动态调整。
+
+满足 Lockable 要求（lock / try_lock / unlock），所以 std::unique_lock、
+std::lock_guard、std::lock 都可以直接使用。
+
+统计（可选，构造时打开）：加锁次数、发生竞争的次数、自旋次数、睡眠总时长。
+*/
+
+namespace futex {
+
+inline long wait(std::atomic<uint32_t> *addr, uint32_t expected,
+                 const timespec *timeout = nullptr) {
+  return syscall(SYS_futex, reinterpret_cast<uint32_t *>(addr),
+                 FUTEX_WAIT_PRIVATE, expected, timeout, nullptr, 0);
+}
+
+inline long wake(std::atomic<uint32_t> *addr, int count) {
+  return syscall(SYS_futex, reinterpret_cast<uint32_t *>(addr),
+                 FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+  _mm_pause();
+#endif
+}
+
+} // namespace futex
+
+// 锁统计的快照（普通整数，方便打印）
+struct LockStats {
+  uint64_t acquisitions = 0; // 成功加锁次数
+  uint64_t contended = 0;    // 第一次 CAS 没抢到锁的次数
+  uint64_t spins = 0;        // 自旋等待的总循环数
+  uint64_t parks = 0;        // 进入内核睡眠的次数
+  uint64_t parkNanos = 0;    // 睡眠总时长（纳秒）
+};
+
+class Mutex {
+public:
+  explicit Mutex(bool collectStats = false) : statsEnabled_(collectStats) {}
+
+  Mutex(const Mutex &) = delete;
+  Mutex &operator=(const Mutex &) = delete;
+
+  void lock() {
+    uint32_t expected = 0;
+    if (state_.compare_exchange_strong(expected, 1, std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+      count(counters_.acquisitions, 1);
+      return;
+    }
+    lock_slow();
+  }
+
+  bool try_lock() {
+    uint32_t expected = 0;
+    if (state_.compare_exchange_strong(expected, 1, std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+      count(counters_.acquisitions, 1);
+      return true;
+    }
+    return false;
+  }
+
+  void unlock() {
+    // 1 -> 0：没有等待者，直接返回；2 -> 0：需要唤醒一个等待者
+    if (state_.exchange(0, std::memory_order_release) == 2)
+      futex::wake(&state_, 1);
+  }
+
+  void enable_stats(bool on) {
+    statsEnabled_.store(on, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] LockStats stats() const {
+    LockStats s;
+    s.acquisitions = counters_.acquisitions.load(std::memory_order_relaxed);
+    s.contended = counters_.contended.load(std::memory_order_relaxed);
+    s.spins = counters_.spins.load(std::memory_order_relaxed);
+    s.parks = counters_.parks.load(std::memory_order_relaxed);
+    s.parkNanos = counters_.parkNanos.load(std::memory_order_relaxed);
+    return s;
+  }
+
+  void reset_stats() {
+    counters_.acquisitions = 0;
+    counters_.contended = 0;
+    counters_.spins = 0;
+    counters_.parks = 0;
+    counters_.parkNanos = 0;
+  }
+
+private:
+  friend class CondVar;
+
+  static constexpr uint32_t kMaxSpin = 1000;
+  static constexpr uint32_t kMinSpin = 16;
+
+  void lock_slow() {
+    count(counters_.contended, 1);
+
+    // 一、自旋：锁很快会被释放时，避免进内核
+    const uint32_t limit = spinLimit_.load(std::memory_order_relaxed);
+    uint32_t spins = 0;
+    while (spins < limit) {
+      ++spins;
+      futex::cpu_relax();
+      uint32_t expected = 0;
+      // 先读再 CAS，避免自旋时反复写缓存行
+      if (state_.load(std::memory_order_relaxed) == 0 &&
+          state_.compare_exchange_weak(expected, 1, std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+        count(counters_.spins, spins);
+        count(counters_.acquisitions, 1);
+        // 自旋成功：上限向本次实际用量的 2 倍靠拢
+        adapt_spin(std::min(kMaxSpin, spins * 2));
+        return;
+      }
+    }
+    count(counters_.spins, spins);
+    // 自旋失败：缩小上限，少浪费 CPU
+    adapt_spin(kMinSpin);
+
+    // 二、睡眠：把状态改为 2（有等待者），只要原来不是 0 就睡
+    lock_contended();
+  }
+
+  // 以"有等待者"状态加锁；CondVar 被唤醒后也走这里，保证 unlock 会继续唤醒其他人
+  void lock_contended() {
+    uint32_t prev = state_.exchange(2, std::memory_order_acquire);
+    if (prev != 0) {
+      const bool timed = statsEnabled_.load(std::memory_order_relaxed);
+      const auto start = timed ? std::chrono::steady_clock::now()
+                               : std::chrono::steady_clock::time_point{};
+      uint64_t parks = 0;
+      while (prev != 0) {
+        ++parks;
+        futex::wait(&state_, 2);
+        prev = state_.exchange(2, std::memory_order_acquire);
+      }
+      if (timed) {
+        count(counters_.parks, parks);
+        count(counters_.parkNanos,
+              static_cast<uint64_t>(
+                  std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now() - start)
+                      .count()));
+      }
+    }
+    count(counters_.acquisitions, 1);
+  }
+
+  void adapt_spin(uint32_t target) {
+    // 指数滑动平均：limit += (target - limit) / 8
+    const uint32_t cur = spinLimit_.load(std::memory_order_relaxed);
+    const int32_t delta =
+        (static_cast<int32_t>(target) - static_cast<int32_t>(cur)) / 8;
+    uint32_t next = static_cast<uint32_t>(static_cast<int32_t>(cur) + delta);
+    next = std::max(kMinSpin, std::min(kMaxSpin, next));
+    spinLimit_.store(next, std::memory_order_relaxed);
+  }
+
+  void count(std::atomic<uint64_t> &counter, uint64_t n) {
+    if (statsEnabled_.load(std::memory_order_relaxed))
+      counter.fetch_add(n, std::memory_order_relaxed);
+  }
+
+  std::atomic<uint32_t> state_{0};
+  std::atomic<uint32_t> spinLimit_{100};
+  std::atomic<bool> statsEnabled_;
+
+  // 统计计数器放到独立缓存行，避免和锁状态字互相干扰
+  struct alignas(64) Counters {
+    std::atomic<uint64_t> acquisitions{0};
+    std::atomic<uint64_t> contended{0};
+    std::atomic<uint64_t> spins{0};
+    std::atomic<uint64_t> parks{0};
+    std::atomic<uint64_t> parkNanos{0};
+  } counters_;
+};
+
+/*
+CondVar：futex 等在一个序号上
+  wait：记下当前序号 -> 解锁 -> FUTEX_WAIT(序号没变才睡) -> 重新加锁
+  notify：序号 +1 -> FUTEX_WAKE
+  先读序号再解锁，保证"解锁后、睡眠前"发生的 notify 不会丢失
+  （序号已变，FUTEX_WAIT 会立即返回）。
+  和 std::condition_variable 一样可能虚假唤醒，请使用带谓词的 wait。
+*/
+class CondVar {
+public:
+  CondVar() = default;
+  CondVar(const CondVar &) = delete;
+  CondVar &operator=(const CondVar &) = delete;
+
+  void wait(std::unique_lock<Mutex> &lock) {
+    Mutex &m = *lock.mutex();
+    const uint32_t seq = seq_.load(std::memory_order_relaxed);
+    m.unlock();
+    futex::wait(&seq_, seq);
+    m.lock_contended();
+  }
+
+  template <typename Pred> void wait(std::unique_lock<Mutex> &lock, Pred pred) {
+    while (!pred())
+      wait(lock);
+  }
+
+  template <typename Rep, typename Period>
+  std::cv_status wait_for(std::unique_lock<Mutex> &lock,
+                          const std::chrono::duration<Rep, Period> &rel) {
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(rel);
+    if (ns.count() <= 0)
+      return std::cv_status::timeout;
+    timespec ts{};
+    ts.tv_sec = static_cast<time_t>(ns.count() / 1000000000);
+    ts.tv_nsec = static_cast<long>(ns.count() % 1000000000);
+
+    Mutex &m = *lock.mutex();
+    const uint32_t seq = seq_.load(std::memory_order_relaxed);
+    m.unlock();
+    const long rc = futex::wait(&seq_, seq, &ts);
+    const int err = errno;
+    m.lock_contended();
+    return rc == -1 && err == ETIMEDOUT ? std::cv_status::timeout
+                                        : std::cv_status::no_timeout;
+  }
+
+  template <typename Rep, typename Period, typename Pred>
+  bool wait_for(std::unique_lock<Mutex> &lock,
+                const std::chrono::duration<Rep, Period> &rel, Pred pred) {
+    const auto deadline = std::chrono::steady_clock::now() + rel;
+    while (!pred()) {
+      const auto left = deadline - std::chrono::steady_clock::now();
+      if (left <= std::chrono::steady_clock::duration::zero())
+        return pred();
+      wait_for(lock, left);
+    }
+    return true;
+  }
+
+  void notify_one() {
+    seq_.fetch_add(1, std::memory_order_relaxed);
+    futex::wake(&seq_, 1);
+  }
+
+  void notify_all() {
+    seq_.fetch_add(1, std::memory_order_relaxed);
+    futex::wake(&seq_, INT_MAX);
+  }
+
+private:
+  std::atomic<uint32_t> seq_{0};
+};
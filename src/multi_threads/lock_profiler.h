@@ -0,0 +1,399 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <source_location>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+锁等待/持有时间剖析器
+  找出"哪段临界区最伤"：比如 BankAccount::deposit 在持锁时打印 std::cout。
+
+  1. ProfiledMutex<M>：包装任意 Lockable，记录
+       等待时间 = 调用 lock 到真正拿到锁
+       持有时间 = 拿到锁到 unlock
+  2. 按调用点（std::source_location：文件 + 行号 + 函数）分别统计，
+     每个调用点两个对数-线性直方图（wait / hold）。
+  3. 记录写入线程局部缓冲区（thread_local），剖析器本身不引入新的锁竞争；
+     线程退出时把缓冲区合并到全局，出报告时再汇总所有存活线程。
+  4. 报告按总等待时间排序，进程退出时自动输出，也可以随时调用 report()。
+
+  调用点要在用户代码里取到，所以用 ProfiledLock 守卫（构造函数默认参数
+  std::source_location::current() 在调用处求值）；直接把 ProfiledMutex 交给
+  std::unique_lock 也能工作，但调用点会落在标准库内部。
+*/
+namespace lockprof {
+
+using Clock = std::chrono::steady_clock;
+
+/*
+对数-线性直方图（类似 HdrHistogram 的简化版）
+  按 2 的幂分组，每组再线性分成 kSub 个桶：
+  [0,4) 每个值一个桶；之后 [2^e, 2^(e+1)) 分 4 个等宽桶。
+  相对误差 <= 25%，64 位范围只需要 256 个桶。
+*/
+class Histogram {
+public:
+  static constexpr int kSubBits = 2;
+  static constexpr int kSub = 1 << kSubBits;
+  static constexpr int kBuckets = 64 * kSub;
+
+  static int bucket_of(uint64_t v) {
+    if (v < kSub)
+      return static_cast<int>(v);
+    const int e = 63 - std::countl_zero(v); // 最高位位置
+    const int sub = static_cast<int>((v >> (e - kSubBits)) & (kSub - 1));
+    return (e - kSubBits + 1) * kSub + sub;
+  }
+
+  // 桶的下界，用于估算分位数
+  static uint64_t bucket_floor(int b) {
+    if (b < kSub)
+      return static_cast<uint64_t>(b);
+    const int e = b / kSub + kSubBits - 1;
+    const uint64_t sub = static_cast<uint64_t>(b % kSub);
+    return (uint64_t{1} << e) | (sub << (e - kSubBits));
+  }
+
+  // 只有拥有者线程写：load + store，不需要原子 RMW
+  void record(uint64_t v) {
+    bump(counts_[bucket_of(v)], 1);
+    bump(total_, v);
+    bump(n_, 1);
+    if (v > max_.load(std::memory_order_relaxed))
+      max_.store(v, std::memory_order_relaxed);
+  }
+
+  // 合并到另一个直方图（加锁后调用）
+  void merge_into(Histogram &other) const {
+    for (int i = 0; i < kBuckets; ++i)
+      bump(other.counts_[i], counts_[i].load(std::memory_order_relaxed));
+    bump(other.total_, total_.load(std::memory_order_relaxed));
+    bump(other.n_, n_.load(std::memory_order_relaxed));
+    const uint64_t m = max_.load(std::memory_order_relaxed);
+    if (m > other.max_.load(std::memory_order_relaxed))
+      other.max_.store(m, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] uint64_t count() const {
+    return n_.load(std::memory_order_relaxed);
+  }
+  [[nodiscard]] uint64_t total() const {
+    return total_.load(std::memory_order_relaxed);
+  }
+  [[nodiscard]] uint64_t max() const {
+    return max_.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] uint64_t percentile(double p) const {
+    const uint64_t n = count();
+    if (n == 0)
+      return 0;
+    const auto rank = static_cast<uint64_t>(p * static_cast<double>(n - 1));
+    uint64_t seen = 0;
+    for (int i = 0; i < kBuckets; ++i) {
+      seen += counts_[i].load(std::memory_order_relaxed);
+      if (seen > rank)
+        return bucket_floor(i);
+    }
+    return max();
+  }
+
+private:
+  static void bump(std::atomic<uint64_t> &c, uint64_t n) {
+    c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+  }
+
+  std::array<std::atomic<uint64_t>, kBuckets> counts_{};
+  std::atomic<uint64_t> total_{0};
+  std::atomic<uint64_t> n_{0};
+  std::atomic<uint64_t> max_{0};
+};
+
+// 一个调用点的统计
+struct SiteStats {
+  Histogram wait;
+  Histogram hold;
+};
+
+struct SiteKey {
+  const char *file;
+  const char *function;
+  uint32_t line;
+
+  bool operator==(const SiteKey &o) const {
+    return line == o.line && file == o.file && function == o.function;
+  }
+};
+
+struct SiteKeyHash {
+  size_t operator()(const SiteKey &k) const {
+    return std::hash<const void *>()(k.file) ^
+           (std::hash<const void *>()(k.function) << 1) ^ k.line;
+  }
+};
+
+class Profiler;
+
+// 每个线程一份：调用点 -> 统计
+class ThreadBuffer {
+public:
+  explicit ThreadBuffer(Profiler &owner);
+  ~ThreadBuffer(); // 线程退出时合并到全局
+
+  SiteStats &site(const std::source_location &loc) {
+    const SiteKey key{loc.file_name(), loc.function_name(), loc.line()};
+    auto it = sites_.find(key);
+    if (it != sites_.end())
+      return *it->second;
+    return add_site(key);
+  }
+
+private:
+  friend class Profiler;
+  SiteStats &add_site(const SiteKey &key);
+
+  Profiler &owner_;
+  // 只在第一次见到调用点时修改，由 mapMtx_ 保护，避免与 report() 并发遍历冲突
+  std::mutex mapMtx_;
+  std::unordered_map<SiteKey, std::unique_ptr<SiteStats>, SiteKeyHash> sites_;
+};
+
+class Profiler {
+public:
+  static Profiler &instance() {
+    static Profiler profiler;
+    return profiler;
+  }
+
+  void set_enabled(bool on) { enabled_.store(on, std::memory_order_relaxed); }
+  [[nodiscard]] bool enabled() const {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  // 进程退出时是否自动打印报告（默认打印）
+  void set_report_at_exit(bool on) { reportAtExit_ = on; }
+
+  ThreadBuffer &local() {
+    thread_local ThreadBuffer buffer(*this);
+    return buffer;
+  }
+
+  void record(const std::source_location &loc, uint64_t waitNs,
+              uint64_t holdNs) {
+    SiteStats &s = local().site(loc);
+    s.wait.record(waitNs);
+    s.hold.record(holdNs);
+  }
+
+  // 汇总所有线程，按总等待时间降序输出前 topN 个调用点
+  void report(FILE *out = stderr, size_t topN = 20) {
+    struct Row {
+      SiteKey key;
+      SiteStats stats;
+    };
+    std::vector<std::unique_ptr<Row>> rows;
+    std::unordered_map<SiteKey, Row *, SiteKeyHash> index;
+    auto merge = [&](const SiteKey &key, const SiteStats &s) {
+      Row *&row = index[key];
+      if (row == nullptr) {
+        rows.push_back(std::make_unique<Row>());
+        row = rows.back().get();
+        row->key = key;
+      }
+      s.wait.merge_into(row->stats.wait);
+      s.hold.merge_into(row->stats.hold);
+    };
+
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      for (const auto &[key, s] : retired_)
+        merge(key, *s);
+      for (ThreadBuffer *buf : live_) {
+        std::lock_guard<std::mutex> mapLock(buf->mapMtx_);
+        for (const auto &[key, s] : buf->sites_)
+          merge(key, *s);
+      }
+    }
+
+    std::sort(rows.begin(), rows.end(), [](const auto &a, const auto &b) {
+      return a->stats.wait.total() > b->stats.wait.total();
+    });
+
+    std::fprintf(out, "\n===== 锁剖析报告（按总等待时间排序，单位 us）=====\n");
+    std::fprintf(out, "%-40s %9s %10s %8s %8s %10s %8s\n", "调用点", "次数",
+                 "总等待", "p50等待", "p99等待", "总持有", "p99持有");
+    for (size_t i = 0; i < rows.size() && i < topN; ++i) {
+      const Row &r = *rows[i];
+      const std::string file = r.key.file;
+      const std::string site =
+          file.substr(file.find_last_of('/') + 1) + ":" +
+          std::to_string(r.key.line);
+      std::fprintf(out, "%-40s %9llu %10.1f %8.2f %8.2f %10.1f %8.2f\n",
+                   site.c_str(),
+                   static_cast<unsigned long long>(r.stats.wait.count()),
+                   static_cast<double>(r.stats.wait.total()) / 1e3,
+                   static_cast<double>(r.stats.wait.percentile(0.5)) / 1e3,
+                   static_cast<double>(r.stats.wait.percentile(0.99)) / 1e3,
+                   static_cast<double>(r.stats.hold.total()) / 1e3,
+                   static_cast<double>(r.stats.hold.percentile(0.99)) / 1e3);
+      std::fprintf(out, "    %s\n", r.key.function);
+    }
+  }
+
+private:
+  friend class ThreadBuffer;
+
+  Profiler() = default;
+  ~Profiler() {
+    if (reportAtExit_)
+      report();
+  }
+
+  void attach(ThreadBuffer *buf) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    live_.push_back(buf);
+  }
+
+  void detach(ThreadBuffer *buf) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    live_.erase(std::remove(live_.begin(), live_.end(), buf), live_.end());
+    for (auto &[key, s] : buf->sites_) {
+      auto &dst = retired_[key];
+      if (!dst)
+        dst = std::make_unique<SiteStats>();
+      s->wait.merge_into(dst->wait);
+      s->hold.merge_into(dst->hold);
+    }
+  }
+
+  std::atomic<bool> enabled_{true};
+  bool reportAtExit_ = true;
+  std::mutex mtx_; // 只保护注册/注销/出报告，不在记录路径上
+  std::vector<ThreadBuffer *> live_;
+  std::unordered_map<SiteKey, std::unique_ptr<SiteStats>, SiteKeyHash>
+      retired_;
+};
+
+inline ThreadBuffer::ThreadBuffer(Profiler &owner) : owner_(owner) {
+  owner_.attach(this);
+}
+
+inline ThreadBuffer::~ThreadBuffer() { owner_.detach(this); }
+
+inline SiteStats &ThreadBuffer::add_site(const SiteKey &key) {
+  std::lock_guard<std::mutex> lock(mapMtx_);
+  auto &slot = sites_[key];
+  slot = std::make_unique<SiteStats>();
+  return *slot;
+}
+
+inline uint64_t nanos_between(Clock::time_point a, Clock::time_point b) {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(b - a).count());
+}
+
+} // namespace lockprof
+
+// 被剖析的互斥量：M 可以是 std::mutex、futex_mutex.h 里的 Mutex 等
+template <typename M = std::mutex> class ProfiledMutex {
+public:
+  ProfiledMutex() = default;
+  ProfiledMutex(const ProfiledMutex &) = delete;
+  ProfiledMutex &operator=(const ProfiledMutex &) = delete;
+
+  void lock(std::source_location loc = std::source_location::current()) {
+    if (!lockprof::Profiler::instance().enabled()) {
+      mtx_.lock();
+      site_ = nullptr;
+      return;
+    }
+    const auto start = lockprof::Clock::now();
+    mtx_.lock();
+    // 以下字段只在持锁期间由持有者读写
+    acquired_ = lockprof::Clock::now();
+    waitNs_ = lockprof::nanos_between(start, acquired_);
+    loc_ = loc;
+    site_ = &loc_;
+  }
+
+  bool try_lock(std::source_location loc = std::source_location::current()) {
+    if (!mtx_.try_lock())
+      return false;
+    acquired_ = lockprof::Clock::now();
+    waitNs_ = 0;
+    loc_ = loc;
+    site_ = lockprof::Profiler::instance().enabled() ? &loc_ : nullptr;
+    return true;
+  }
+
+  void unlock() {
+    if (site_ != nullptr) {
+      const uint64_t holdNs =
+          lockprof::nanos_between(acquired_, lockprof::Clock::now());
+      const std::source_location loc = loc_;
+      const uint64_t waitNs = waitNs_;
+      mtx_.unlock();
+      // 记录放在解锁之后，不拉长临界区
+      lockprof::Profiler::instance().record(loc, waitNs, holdNs);
+      return;
+    }
+    mtx_.unlock();
+  }
+
+  M &native() { return mtx_; }
+
+private:
+  M mtx_;
+  lockprof::Clock::time_point acquired_{};
+  uint64_t waitNs_ = 0;
+  std::source_location loc_{};
+  const std::source_location *site_ = nullptr;
+};
+
+// RAII 守卫：用法同 std::unique_lock，但会记录调用点
+template <typename M> class ProfiledLock {
+public:
+  explicit ProfiledLock(
+      ProfiledMutex<M> &m,
+      std::source_location loc = std::source_location::current())
+      : mtx_(&m) {
+    mtx_->lock(loc);
+    owns_ = true;
+  }
+
+  ProfiledLock(ProfiledMutex<M> &m, std::defer_lock_t) : mtx_(&m) {}
+
+  ~ProfiledLock() {
+    if (owns_)
+      mtx_->unlock();
+  }
+
+  ProfiledLock(const ProfiledLock &) = delete;
+  ProfiledLock &operator=(const ProfiledLock &) = delete;
+
+  void lock(std::source_location loc = std::source_location::current()) {
+    mtx_->lock(loc);
+    owns_ = true;
+  }
+
+  void unlock() {
+    mtx_->unlock();
+    owns_ = false;
+  }
+
+  [[nodiscard]] bool owns_lock() const { return owns_; }
+
+private:
+  ProfiledMutex<M> *mtx_;
+  bool owns_ = false;
+};
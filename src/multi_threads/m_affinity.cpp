@@ -0,0 +1,144 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "cpu_topology.h"
+#include "thread_pool.h"
+
+/*
+绑核 / NUMA 放置演示与基准
+  一、打印本机拓扑，以及三种放置策略给出的 CPU 分配
+  二、线程池负载：每个工作线程反复扫描"自己的"一块内存
+      - none：不绑核，内存由主线程分配（可能在远端节点）
+      - compact / scatter：绑核，内存在工作线程启动时按本地节点分配
+  三、队列负载：生产者/消费者通过 mutex 队列传递数据，对比不绑核与两种放置
+      （事件循环线程同理：进入 epoll_wait 循环之前调用 pin_current_thread，见 network/epoll.cpp）
+*/
+
+using Clock = std::chrono::steady_clock;
+
+double seconds_since(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// 每个工作线程的私有数据：线程池 onStart 时设置
+thread_local NumaMemory *localBuffer = nullptr;
+
+double bench_pool(const CpuTopology &topo, Placement policy, size_t workers) {
+  constexpr size_t kBytes = 16 << 20; // 每个工作线程 16MB
+  const std::vector<int> cpus = topo.plan(policy, workers);
+
+  // 不绑核时，内存全部由主线程预先分配（首次访问落在主线程所在节点）；
+  // 绑核时由各工作线程自己分配，主线程只负责最后释放
+  std::vector<std::unique_ptr<NumaMemory>> buffers(workers);
+  if (policy == Placement::None) {
+    for (auto &b : buffers)
+      b = std::make_unique<NumaMemory>(kBytes, -1);
+  }
+
+  std::atomic<size_t> ready{0};
+  ThreadPool pool(workers, [&](size_t i) {
+    if (policy != Placement::None) {
+      pin_current_thread(cpus[i]);
+      // 绑核之后再分配，内存落在本地节点
+      buffers[i] = std::make_unique<NumaMemory>(kBytes, topo.node_of(cpus[i]));
+    }
+    localBuffer = buffers[i].get();
+    ready.fetch_add(1);
+  });
+  while (ready.load() < workers)
+    std::this_thread::yield();
+
+  const auto start = Clock::now();
+  std::vector<std::future<uint64_t>> results;
+  for (int round = 0; round < 8; ++round) {
+    for (size_t i = 0; i < workers; ++i) {
+      results.push_back(pool.submit([] {
+        const auto *p = localBuffer->as<uint64_t>();
+        const size_t n = localBuffer->size() / sizeof(uint64_t);
+        uint64_t sum = 0;
+        for (size_t k = 0; k < n; k += 8) // 每条缓存行读一次
+          sum += p[k];
+        return sum;
+      }));
+    }
+  }
+  for (auto &f : results)
+    f.get();
+  return seconds_since(start);
+}
+
+double bench_queue(const CpuTopology &topo, Placement policy) {
+  const std::vector<int> cpus = topo.plan(policy, 2);
+  std::queue<int> q;
+  std::mutex mtx;
+  std::condition_variable cv;
+  constexpr int kItems = 200000;
+
+  const auto start = Clock::now();
+  std::thread producer([&] {
+    pin_current_thread(cpus[0]);
+    for (int i = 0; i < kItems; ++i) {
+      {
+        std::lock_guard<std::mutex> lock(mtx);
+        q.push(i);
+      }
+      cv.notify_one();
+    }
+  });
+  std::thread consumer([&] {
+    pin_current_thread(cpus[1]);
+    int received = 0;
+    while (received < kItems) {
+      std::unique_lock<std::mutex> lock(mtx);
+      cv.wait(lock, [&] { return !q.empty(); });
+      while (!q.empty()) {
+        q.pop();
+        ++received;
+      }
+    }
+  });
+  producer.join();
+  consumer.join();
+  return seconds_since(start);
+}
+
+int main() {
+  const CpuTopology topo = CpuTopology::detect();
+
+  // 一、拓扑
+  std::cout << "逻辑CPU\t节点\tsocket\t物理核\t超线程" << std::endl;
+  for (const CpuInfo &c : topo.cpus())
+    std::cout << c.cpu << "\t" << c.node << "\t" << c.package << "\t" << c.core
+              << "\t" << c.smt << std::endl;
+  std::cout << "NUMA 节点数: " << topo.nodes().size() << std::endl;
+
+  const size_t workers = std::max<size_t>(2, topo.cpus().size());
+  for (Placement p :
+       {Placement::Compact, Placement::Scatter, Placement::SingleNode}) {
+    std::cout << placement_name(p) << ":";
+    for (int cpu : topo.plan(p, workers))
+      std::cout << " " << cpu;
+    std::cout << std::endl;
+  }
+
+  // 二、线程池负载
+  std::cout << "\n线程池扫描本地内存 (" << workers << " 线程)" << std::endl;
+  for (Placement p : {Placement::None, Placement::Compact, Placement::Scatter})
+    std::cout << "  " << placement_name(p) << ": "
+              << bench_pool(topo, p, workers) << " s" << std::endl;
+
+  // 三、队列负载
+  std::cout << "\n生产者/消费者队列" << std::endl;
+  for (Placement p : {Placement::None, Placement::Compact, Placement::Scatter})
+    std::cout << "  " << placement_name(p) << ": " << bench_queue(topo, p)
+              << " s" << std::endl;
+  return 0;
+}
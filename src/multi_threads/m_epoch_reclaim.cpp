@@ -0,0 +1,202 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "epoch_reclaim.h"
+
+/*
+EBR / Hazard Pointer 回收开销基准
+  Michael-Scott 无锁队列，32 个线程各自做 enqueue + dequeue，
+  出队后的旧哨兵节点交给不同的回收策略：
+    leak   不回收（只为对比回收本身的开销，真实代码不能这样）
+    ebr    基于纪元的回收
+    hazard 风险指针
+  最后打印吞吐量，以及结束时还有多少节点尚未释放（EBR 无上界，HP 有上界）。
+*/
+
+enum class Policy { Leak, Ebr, Hazard };
+
+const char *policy_name(Policy p) {
+  switch (p) {
+  case Policy::Leak:
+    return "leak";
+  case Policy::Ebr:
+    return "ebr";
+  case Policy::Hazard:
+    return "hazard";
+  }
+  return "?";
+}
+
+template <Policy P> class MSQueue {
+  struct Node {
+    int value;
+    std::atomic<Node *> next{nullptr};
+    explicit Node(int v) : value(v) {}
+  };
+
+public:
+  // maxRetired：leak 策略下预留的"坟场"大小
+  MSQueue(reclaim::EpochDomain &ebr, reclaim::HazardDomain &hp,
+          size_t maxRetired)
+      : ebr_(ebr), hp_(hp), leaked_(P == Policy::Leak ? maxRetired : 0) {
+    Node *dummy = new Node(0);
+    head_.store(dummy);
+    tail_.store(dummy);
+  }
+
+  ~MSQueue() {
+    Node *n = head_.load();
+    while (n != nullptr) {
+      Node *next = n->next.load();
+      delete n;
+      n = next;
+    }
+    for (size_t i = 0; i < leakedCount_.load(); ++i)
+      delete leaked_[i];
+  }
+
+  void enqueue(int v) {
+    Node *node = new Node(v);
+    [[maybe_unused]] auto guard = pin();
+    reclaim::HazardDomain::Holder h0(hp_, 0);
+    while (true) {
+      Node *t = protect(h0, tail_);
+      Node *next = t->next.load(std::memory_order_acquire);
+      if (t != tail_.load(std::memory_order_acquire))
+        continue;
+      if (next == nullptr) {
+        if (t->next.compare_exchange_weak(next, node,
+                                          std::memory_order_release)) {
+          tail_.compare_exchange_strong(t, node, std::memory_order_release);
+          return;
+        }
+      } else {
+        // 尾指针落后了，帮忙推进
+        tail_.compare_exchange_strong(t, next, std::memory_order_release);
+      }
+    }
+  }
+
+  bool dequeue(int &out) {
+    [[maybe_unused]] auto guard = pin();
+    reclaim::HazardDomain::Holder h0(hp_, 0);
+    reclaim::HazardDomain::Holder h1(hp_, 1);
+    while (true) {
+      Node *h = protect(h0, head_);
+      Node *t = tail_.load(std::memory_order_acquire);
+      Node *next = protect(h1, h->next);
+      if (h != head_.load(std::memory_order_acquire))
+        continue;
+      if (next == nullptr)
+        return false;
+      if (h == t) {
+        tail_.compare_exchange_strong(t, next, std::memory_order_release);
+        continue;
+      }
+      out = next->value;
+      if (head_.compare_exchange_strong(h, next, std::memory_order_acq_rel)) {
+        retire(h);
+        return true;
+      }
+    }
+  }
+
+private:
+  // EBR 需要在整个操作期间 pin 住；其他策略返回一个空对象
+  auto pin() {
+    if constexpr (P == Policy::Ebr)
+      return ebr_.pin();
+    else
+      return 0;
+  }
+
+  Node *protect(reclaim::HazardDomain::Holder &h, std::atomic<Node *> &src) {
+    if constexpr (P == Policy::Hazard)
+      return h.protect(src);
+    else
+      return src.load(std::memory_order_acquire);
+  }
+
+  void retire(Node *n) {
+    if constexpr (P == Policy::Ebr) {
+      ebr_.retire(n);
+    } else if constexpr (P == Policy::Hazard) {
+      hp_.retire(n);
+    } else {
+      // 不回收：记到预分配的数组里，只在析构时统一释放
+      leaked_[leakedCount_.fetch_add(1, std::memory_order_relaxed)] = n;
+    }
+  }
+
+  alignas(64) std::atomic<Node *> head_;
+  alignas(64) std::atomic<Node *> tail_;
+  reclaim::EpochDomain &ebr_;
+  reclaim::HazardDomain &hp_;
+  std::vector<Node *> leaked_;
+  std::atomic<size_t> leakedCount_{0};
+};
+
+template <Policy P> void bench(int threads, int opsPerThread) {
+  reclaim::EpochDomain ebr;
+  reclaim::HazardDomain hp;
+  uint64_t unreclaimed = 0;
+  double sec = 0;
+  {
+    MSQueue<P> q(ebr, hp, static_cast<size_t>(threads) * opsPerThread);
+    std::atomic<bool> go{false};
+    std::vector<std::thread> ts;
+    for (int t = 0; t < threads; ++t) {
+      ts.emplace_back([&, t] {
+        while (!go.load())
+          std::this_thread::yield();
+        int v = 0;
+        for (int i = 0; i < opsPerThread; ++i) {
+          q.enqueue(t * opsPerThread + i);
+          q.dequeue(v);
+        }
+      });
+    }
+    const auto start = std::chrono::steady_clock::now();
+    go = true;
+    for (auto &th : ts)
+      th.join();
+    sec = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                        start)
+              .count();
+    if constexpr (P == Policy::Ebr)
+      unreclaimed = ebr.retired() - ebr.reclaimed();
+    else if constexpr (P == Policy::Hazard)
+      unreclaimed = hp.retired() - hp.reclaimed();
+    else
+      unreclaimed = static_cast<uint64_t>(threads) * opsPerThread;
+  }
+  const double ops = 2.0 * threads * opsPerThread;
+  std::cout << policy_name(P) << "\t" << ops / sec / 1e6 << " Mops/s\t结束时未回收节点: "
+            << unreclaimed << std::endl;
+}
+
+int main() {
+  // 一、EBR 基本用法
+  auto &domain = reclaim::EpochDomain::global();
+  {
+    auto guard = domain.pin(); // 读共享结构前 pin
+    domain.retire(new int(42)); // 摘下的节点退休，等安全时 delete
+  }
+  for (int i = 0; i < 4; ++i)
+    domain.collect(); // 没有其他线程时，推进几次纪元即可全部回收
+  std::cout << "EBR 退休 " << domain.retired() << "，已回收 "
+            << domain.reclaimed() << "，纪元 " << domain.epoch() << std::endl;
+
+  // 二、32 线程无锁队列回收开销
+  const int threads = 32;
+  const int ops = 20000;
+  std::cout << "\n" << threads << " 线程，每线程 " << ops
+            << " 次 enqueue+dequeue" << std::endl;
+  bench<Policy::Leak>(threads, ops);
+  bench<Policy::Ebr>(threads, ops);
+  bench<Policy::Hazard>(threads, ops);
+  return 0;
+}
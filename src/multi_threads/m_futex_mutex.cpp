@@ -0,0 +1,169 @@
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "futex_mutex.h"
+
+/*
+futex Mutex / CondVar 演示
+  一、替换 BankAccount 里的 std::mutex：unique_lock / std::lock 用法不变
+  二、用 CondVar 写生产者-消费者（对照 m_condition.cpp）
+  三、竞争基准：std::mutex vs futex Mutex，并打印竞争统计
+*/
+
+// 与 m_mutex_unique_lock.cpp 相同的账户，只是锁类型变成模板参数
+template <typename Lock> class BankAccount {
+private:
+  Lock mtx;
+  double balance;
+
+public:
+  template <typename... LockArgs>
+  explicit BankAccount(double initial, LockArgs &&...args)
+      : mtx(std::forward<LockArgs>(args)...), balance(initial) {}
+
+  void deposit(double amount) {
+    std::unique_lock<Lock> lock(mtx);
+    balance += amount;
+  }
+
+  void withdraw(double amount) {
+    std::unique_lock<Lock> lock(mtx);
+    if (balance >= amount)
+      balance -= amount;
+  }
+
+  void transfer(BankAccount &to, double amount) {
+    std::unique_lock<Lock> lock1(mtx, std::defer_lock);
+    std::unique_lock<Lock> lock2(to.mtx, std::defer_lock);
+    std::lock(lock1, lock2); // 原子性地锁定两个，避免死锁
+    if (balance >= amount) {
+      balance -= amount;
+      to.balance += amount;
+    }
+  }
+
+  double getBalance() {
+    std::unique_lock<Lock> lock(mtx);
+    return balance;
+  }
+
+  Lock &lock() { return mtx; }
+};
+
+// 多个线程在两个账户之间来回转账，总额应保持不变
+template <typename Lock, typename... LockArgs>
+double run_transfers(int threads, int iterations, LockArgs... args) {
+  BankAccount<Lock> a(1000, args...);
+  BankAccount<Lock> b(1000, args...);
+  std::vector<std::thread> ts;
+  const auto start = std::chrono::steady_clock::now();
+  for (int t = 0; t < threads; ++t) {
+    ts.emplace_back([&, t] {
+      for (int i = 0; i < iterations; ++i) {
+        if ((i + t) % 2 == 0)
+          a.transfer(b, 1);
+        else
+          b.transfer(a, 1);
+        a.deposit(1);
+        a.withdraw(1);
+      }
+    });
+  }
+  for (auto &th : ts)
+    th.join();
+  const double sec =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+          .count();
+  if (a.getBalance() + b.getBalance() != 2000)
+    std::cerr << "总额不守恒!" << std::endl;
+
+  if constexpr (std::is_same_v<Lock, Mutex>) {
+    const LockStats s = a.lock().stats();
+    std::cout << "  账户 a 锁统计: 加锁 " << s.acquisitions << "，竞争 "
+              << s.contended << "，自旋 " << s.spins << "，睡眠 " << s.parks
+              << " 次 / " << s.parkNanos / 1000 << " us" << std::endl;
+  }
+  return sec;
+}
+
+// 二、CondVar 生产者-消费者
+void producer_consumer() {
+  Mutex mtx;
+  CondVar cv;
+  std::queue<int> q;
+  bool done = false;
+
+  std::thread producer([&] {
+    for (int i = 0; i < 5; ++i) {
+      {
+        std::lock_guard<Mutex> lock(mtx);
+        q.push(i);
+      }
+      cv.notify_one();
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    {
+      std::lock_guard<Mutex> lock(mtx);
+      done = true;
+    }
+    cv.notify_all();
+  });
+
+  std::thread consumer([&] {
+    while (true) {
+      std::unique_lock<Mutex> lock(mtx);
+      cv.wait(lock, [&] { return !q.empty() || done; });
+      if (q.empty())
+        break;
+      const int value = q.front();
+      q.pop();
+      lock.unlock();
+      std::cout << "消费: " << value << std::endl;
+    }
+  });
+
+  producer.join();
+  consumer.join();
+
+  // 超时等待：没有人通知，100ms 后返回 false
+  std::unique_lock<Mutex> lock(mtx);
+  const bool ok =
+      cv.wait_for(lock, std::chrono::milliseconds(100), [] { return false; });
+  std::cout << "wait_for 超时返回: " << std::boolalpha << ok << std::endl;
+}
+
+int main() {
+  // 一、BankAccount 使用 futex Mutex（带统计）
+  BankAccount<Mutex> account1(1000, true);
+  BankAccount<Mutex> account2(500, true);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 5; ++i) {
+    threads.emplace_back([&account1, i]() {
+      account1.deposit(i * 100);
+      account1.withdraw(i * 50);
+    });
+    threads.emplace_back(
+        [&account1, &account2, i]() { account1.transfer(account2, i * 30); });
+  }
+  for (auto &t : threads)
+    t.join();
+  std::cout << "账户1余额: " << account1.getBalance() << std::endl;
+  std::cout << "账户2余额: " << account2.getBalance() << std::endl;
+
+  // 二、条件变量
+  producer_consumer();
+
+  // 三、竞争基准
+  const int iterations = 200000;
+  std::cout << "\n线程数\tstd::mutex(s)\tfutex Mutex(s)" << std::endl;
+  for (int n : {1, 2, 4, 8}) {
+    const double stdSec = run_transfers<std::mutex>(n, iterations);
+    const double futexSec = run_transfers<Mutex>(n, iterations, true);
+    std::cout << n << "\t" << stdSec << "\t\t" << futexSec << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,82 @@
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "futex_mutex.h"
+#include "lock_profiler.h"
+
+/*
+锁剖析器演示
+  BankAccount::deposit 在持锁期间做 I/O（原版是 std::cout << ... << std::endl），
+  withdraw 把 I/O 移到了锁外面。跑完之后报告会把 deposit 的调用点排在最前面：
+  它的持有时间长，导致其他线程在所有调用点上的等待时间都变长。
+
+  为了不刷屏，这里把输出写到 /dev/null，但每次 std::endl 依然会 flush 一次（系统调用）。
+*/
+
+std::ofstream sink("/dev/null");
+
+template <typename M> class BankAccount {
+private:
+  ProfiledMutex<M> mtx;
+  double balance;
+
+public:
+  explicit BankAccount(double initial) : balance(initial) {}
+
+  // 反例：I/O 在临界区里
+  void deposit(double amount) {
+    ProfiledLock<M> lock(mtx);
+    balance += amount;
+    sink << "存入 " << amount << ", 余额: " << balance << std::endl;
+  }
+
+  // 正例：临界区只做计算，I/O 挪到锁外
+  void withdraw(double amount) {
+    double after = 0;
+    bool ok = false;
+    {
+      ProfiledLock<M> lock(mtx);
+      if (balance >= amount) {
+        balance -= amount;
+        ok = true;
+      }
+      after = balance;
+    }
+    if (ok)
+      sink << "取出 " << amount << ", 余额: " << after << std::endl;
+  }
+
+  double getBalance() {
+    ProfiledLock<M> lock(mtx);
+    return balance;
+  }
+};
+
+template <typename M> void run(const char *name) {
+  BankAccount<M> account(1000);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&account] {
+      for (int i = 0; i < 2000; ++i) {
+        account.deposit(10);
+        account.withdraw(5);
+        account.getBalance();
+      }
+    });
+  }
+  for (auto &t : threads)
+    t.join();
+  std::cout << name << " 最终余额: " << account.getBalance() << std::endl;
+}
+
+int main() {
+  run<std::mutex>("std::mutex");
+  run<Mutex>("futex Mutex");
+
+  // 随时可以手动输出报告；这里已经输出过，关掉进程退出时的自动报告以免重复
+  lockprof::Profiler::instance().report(stdout, 5);
+  lockprof::Profiler::instance().set_report_at_exit(false);
+  return 0;
+}
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <mutex>
+#include "seqlock.h"
 #include <thread>
 #include <vector>
 
@@ -68,14 +69,20 @@ class BankAccount {
 private:
   std::mutex mtx; //锁
   double balance; // 余额
+  // 余额快照：写者在持锁时发布，读者无锁读取（读多写少）
+  SeqLock<double> balanceView;
+
+  // 必须在持有 mtx 时调用
+  void publish() { balanceView.store(balance); }
 
 public:
-  BankAccount(double initial) : balance(initial) {}
+  BankAccount(double initial) : balance(initial), balanceView(initial) {}
 
   void deposit(double amount) {
     //防止多个线程同时修改余额造成数据乱序或错误
     std::unique_lock<std::mutex> lock(mtx);
     balance += amount;
+    publish();
     std::cout << "存入 " << amount << ", 余额: " << balance << std::endl;
   }
 
@@ -83,6 +90,7 @@ public:
     std::unique_lock<std::mutex> lock(mtx);
     if (balance >= amount) {
       balance -= amount;
+      publish();
       std::cout << "取出 " << amount << ", 余额: " << balance << std::endl;
     } else {
       std::cout << "余额不足! 尝试取出: " << amount << ", 余额: " << balance
@@ -99,14 +107,14 @@ public:
     if (balance >= amount) {
       balance -= amount;
       to.balance += amount;
+      publish();
+      to.publish();
       std::cout << "转账 " << amount << " 成功" << std::endl;
     }
   }
 
-  double getBalance() {
-    std::unique_lock<std::mutex> lock(mtx);
-    return balance;
-  }
+  // 读路径不再抢写者的互斥锁，而是读 seqlock 快照，见 m_seqlock.cpp
+  double getBalance() const { return balanceView.load(); }
 };
 
 int main() {
@@ -0,0 +1,140 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "seqlock.h"
+
+/*
+seqlock 读路径 vs mutex / shared_mutex
+场景：账户余额、请求计数这类小的 POD 状态，读占 95% 以上。
+
+  std::mutex        读写都独占，读者之间也互相排队
+  std::shared_mutex 读者可并发，但每次 lock_shared 都要原子修改读者计数，
+                    所有读核争抢同一条缓存行
+  SeqLock           读者只读 seq 和数据，不写共享缓存行，读可以随核数扩展
+
+基准：1 个写者持续更新，N 个读者在固定时间内尽可能多地读，统计总读次数。
+*/
+
+// 账户统计：几个字长的小对象，正好适合 seqlock
+struct AccountStats {
+  double balance;
+  uint64_t deposits;
+  uint64_t withdrawals;
+};
+
+// 三种读写策略，接口保持一致
+struct MutexStats {
+  std::mutex mtx;
+  AccountStats stats{};
+
+  AccountStats read() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return stats;
+  }
+  void deposit(double amount) {
+    std::lock_guard<std::mutex> lock(mtx);
+    stats.balance += amount;
+    ++stats.deposits;
+  }
+};
+
+struct SharedMutexStats {
+  std::shared_mutex mtx;
+  AccountStats stats{};
+
+  AccountStats read() {
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    return stats;
+  }
+  void deposit(double amount) {
+    std::unique_lock<std::shared_mutex> lock(mtx);
+    stats.balance += amount;
+    ++stats.deposits;
+  }
+};
+
+struct SeqLockStats {
+  SeqLock<AccountStats> stats;
+
+  AccountStats read() { return stats.load(); }
+  void deposit(double amount) {
+    stats.write([amount](AccountStats &s) {
+      s.balance += amount;
+      ++s.deposits;
+    });
+  }
+};
+
+// 返回每秒总读次数
+template <typename Stats> double bench_readers(int readers) {
+  Stats shared;
+  std::atomic<bool> stop{false};
+  std::atomic<uint64_t> totalReads{0};
+
+  // 写者：持续写，但写得比读少得多
+  std::thread writer([&] {
+    while (!stop.load(std::memory_order_relaxed)) {
+      shared.deposit(1.0);
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+  });
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < readers; ++i) {
+    threads.emplace_back([&] {
+      uint64_t reads = 0;
+      double sink = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        const AccountStats s = shared.read();
+        // 快照内部必须一致：每次存入 1.0，余额应等于存入次数
+        if (s.balance != static_cast<double>(s.deposits))
+          std::cerr << "读到了不一致的快照!" << std::endl;
+        sink += s.balance;
+        ++reads;
+      }
+      totalReads.fetch_add(reads, std::memory_order_relaxed);
+      (void)sink;
+    });
+  }
+
+  const auto duration = std::chrono::milliseconds(300);
+  std::this_thread::sleep_for(duration);
+  stop = true;
+  for (auto &t : threads)
+    t.join();
+  writer.join();
+
+  return static_cast<double>(totalReads.load()) /
+         std::chrono::duration<double>(duration).count();
+}
+
+int main() {
+  // 一、基本用法
+  SeqLock<AccountStats> stats(AccountStats{100.0, 0, 0});
+  stats.write([](AccountStats &s) {
+    s.balance += 50;
+    ++s.deposits;
+  });
+  AccountStats snap = stats.load();
+  std::cout << "余额: " << snap.balance << ", 存款次数: " << snap.deposits
+            << ", 序号: " << stats.sequence() << std::endl;
+
+  // 二、读者扩展性基准
+  std::cout << "\n读者数\tmutex(Mops/s)\tshared_mutex\tseqlock" << std::endl;
+  for (int readers : {1, 2, 4, 8}) {
+    const double m = bench_readers<MutexStats>(readers);
+    const double sm = bench_readers<SharedMutexStats>(readers);
+    const double sl = bench_readers<SeqLockStats>(readers);
+    std::cout << readers << "\t" << m / 1e6 << "\t\t" << sm / 1e6 << "\t\t"
+              << sl / 1e6 << std::endl;
+  }
+  std::cout << "(硬件线程数: " << std::thread::hardware_concurrency() << ")"
+            << std::endl;
+  return 0;
+}
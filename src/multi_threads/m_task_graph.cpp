@@ -0,0 +1,158 @@
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "task_graph.h"
+
+/*
+任务图 / Future 续体演示
+  一、m_thread.cpp 的 sum(1,500) + sum(501,1000)，改写为 when_all + then，不阻塞任何线程
+  二、显式 DAG：load -> (parse, validate) -> merge
+  三、扇出/扇入请求：每个请求拆成 8 个子任务再汇总
+      阻塞写法：每个请求一个 std::async 线程，里面 get() 等 8 个子任务
+      续体写法：4 线程的线程池 + when_all + then，没有线程在 get() 上等待
+*/
+
+long long sum(const int a, const int b) {
+  long long result = 0;
+  for (int i = a; i < b; ++i)
+    result += i;
+  return result;
+}
+
+// 模拟一个子请求的计算量
+long long sub_request(int request, int part) {
+  long long acc = 0;
+  for (int i = 0; i < 20000; ++i)
+    acc += (request * 31 + part * 17 + i) % 7;
+  return acc;
+}
+
+constexpr int kRequests = 200;
+constexpr int kFanOut = 8;
+
+// 阻塞写法：外层线程 get() 等待子任务
+long long blocking_requests() {
+  std::vector<std::future<long long>> requests;
+  for (int r = 0; r < kRequests; ++r) {
+    requests.push_back(std::async(std::launch::async, [r] {
+      std::vector<std::future<long long>> parts;
+      for (int p = 0; p < kFanOut; ++p)
+        parts.push_back(std::async(std::launch::async, sub_request, r, p));
+      long long total = 0;
+      for (auto &f : parts)
+        total += f.get(); // 这个线程在这里被阻塞
+      return total;
+    }));
+  }
+  long long all = 0;
+  for (auto &f : requests)
+    all += f.get();
+  return all;
+}
+
+// 续体写法：所有等待都变成"就绪后再调度"
+long long continuation_requests(ThreadPool &pool) {
+  std::vector<task::Future<long long>> requests;
+  for (int r = 0; r < kRequests; ++r) {
+    std::vector<task::Future<long long>> parts;
+    for (int p = 0; p < kFanOut; ++p)
+      parts.push_back(task::async(pool, sub_request, r, p));
+    requests.push_back(
+        task::when_all(pool, std::move(parts))
+            .then([](std::vector<long long> v) {
+              return std::accumulate(v.begin(), v.end(), 0LL);
+            }));
+  }
+  auto total = task::when_all(pool, std::move(requests))
+                   .then([](std::vector<long long> v) {
+                     return std::accumulate(v.begin(), v.end(), 0LL);
+                   });
+  return task::sync_wait(std::move(total)); // 只有 main 在等
+}
+
+template <typename Fn> double timed(Fn &&fn, long long &out) {
+  const auto start = std::chrono::steady_clock::now();
+  out = fn();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+int main() {
+  ThreadPool pool(4);
+
+  // 一、when_all + then
+  auto f1 = task::async(pool, sum, 1, 500);
+  auto f2 = task::async(pool, sum, 501, 1000);
+  auto total = task::when_all(pool, f1, f2).then(
+      [](std::tuple<long long, long long> t) {
+        return std::get<0>(t) + std::get<1>(t);
+      });
+  std::cout << "sum of 1-1000: " << task::sync_wait(total) << std::endl;
+
+  // 续体链 + 异常传递
+  auto failing = task::async(pool, [] { return 1; })
+                     .then([](int x) -> int {
+                       if (x == 1)
+                         throw std::runtime_error("下游失败");
+                       return x;
+                     })
+                     .then([](int x) { return x * 2; }); // 被跳过
+  try {
+    task::sync_wait(failing);
+  } catch (const std::exception &e) {
+    std::cout << "异常沿续体链传递: " << e.what() << std::endl;
+  }
+
+  // when_any：最先完成的那个
+  std::vector<task::Future<std::string>> replicas;
+  for (int i = 0; i < 3; ++i)
+    replicas.push_back(task::async(pool, [i] {
+      std::this_thread::sleep_for(std::chrono::milliseconds(30 - i * 10));
+      return "replica-" + std::to_string(i);
+    }));
+  auto first = task::sync_wait(task::when_any(pool, replicas));
+  std::cout << "when_any: " << first.second << " (下标 " << first.first << ")"
+            << std::endl;
+  // 等其余副本也结束，避免它们在 replicas 析构后还持有 pool 的任务
+  task::sync_wait(task::when_all(pool, std::move(replicas)));
+
+  // 二、DAG
+  task::TaskGraph graph;
+  std::vector<int> data;
+  long long parsed = 0;
+  bool valid = false;
+  const auto load = graph.emplace([&] {
+    data.resize(1000);
+    std::iota(data.begin(), data.end(), 1);
+  });
+  const auto parse = graph.emplace(
+      [&] { parsed = std::accumulate(data.begin(), data.end(), 0LL); });
+  const auto validate = graph.emplace([&] { valid = data.size() == 1000; });
+  const auto merge = graph.emplace([&] {
+    std::cout << "DAG 合并: sum=" << parsed << ", valid=" << std::boolalpha
+              << valid << std::endl;
+  });
+  graph.precede(load, parse);
+  graph.precede(load, validate);
+  graph.precede(parse, merge);
+  graph.precede(validate, merge);
+  task::sync_wait(graph.run(pool));
+
+  // 三、扇出/扇入
+  long long a = 0, b = 0;
+  const double blockingSec = timed([] { return blocking_requests(); }, a);
+  const double contSec =
+      timed([&] { return continuation_requests(pool); }, b);
+  std::cout << "\n" << kRequests << " 个请求 x " << kFanOut << " 个子任务"
+            << std::endl;
+  std::cout << "  阻塞 get()（每请求一线程）: " << blockingSec << " s，结果 "
+            << a << std::endl;
+  std::cout << "  续体（" << pool.size() << " 线程池）: " << contSec
+            << " s，结果 " << b << std::endl;
+  return 0;
+}
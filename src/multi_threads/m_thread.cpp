@@ -9,9 +9,9 @@
 /*
 https://chatgpt.com/s/t_693bc8130a448191952f3e89c97aa4d9
 */
-//加法函数
-int sum(const int a, const int b) {
-  int result = 0;
+//加法函数（用 long long 累加，区间大时 int 会溢出；大数组归约见 simd/simd_reduce.h）
+long long sum(const int a, const int b) {
+  long long result = 0;
   for (int i = a; i < b; ++i) {
     result += i;
   }
@@ -45,8 +45,8 @@ int main() {
   std::cout << "Hello, World from main!" << std::endl;
 
   //二、 线程传参示例,并且返回
-  std::future<int> result1 = std::async(std::launch::async, sum, 1, 500);
-  std::future<int> result2 = std::async(std::launch::async, sum, 501, 1000);
+  std::future<long long> result1 = std::async(std::launch::async, sum, 1, 500);
+  std::future<long long> result2 = std::async(std::launch::async, sum, 501, 1000);
   std::cout << "sum of 1-1000:" << result1.get() + result2.get() << std::endl;
 
   //三、线程运行成员函数
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+/*
+顺序锁（SeqLock）
+适用场景：读多写少、数据很小（几个字长）且可平凡拷贝（POD）的共享状态，
+例如账户余额、统计计数器、配置快照。
+
+原理：
+  写者：seq 先 +1 变成奇数（表示"正在写"），写入数据，再 +1 变回偶数。
+  读者：读 seq(s1) -> 拷贝数据 -> 再读 seq(s2)，
+        若 s1 为奇数或 s1 != s2，说明读的过程中被写者打断，重试。
+
+与 mutex / shared_mutex 的区别：
+  mutex / shared_mutex 的读者也要修改锁内部的计数（写共享缓存行），
+  读线程越多，缓存行在核间来回弹跳越严重；
+  seqlock 的读者只读不写，多核读可以线性扩展，代价是写者频繁时读者会重试。
+
+注意：
+  1. 数据用 relaxed 原子字逐字读写，避免对普通内存"边写边读"的数据竞争（UB）；
+  2. 多个写者之间通过 CAS 抢占奇数序号互斥，不需要额外的锁；
+  3. 只适合小对象，大对象拷贝时间长，读者更容易被打断。
+*/
+template <typename T> class SeqLock {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "SeqLock 只能保护可平凡拷贝的类型");
+
+public:
+  SeqLock() : SeqLock(T{}) {}
+
+  explicit SeqLock(const T &value) { store_words(value); }
+
+  SeqLock(const SeqLock &) = delete;
+  SeqLock &operator=(const SeqLock &) = delete;
+
+  // 读：无锁、不写任何共享变量，失败就重试
+  T load() const {
+    T out;
+    while (!try_load(out)) {
+      // 写者正在写，稍微让一下
+      std::this_thread::yield();
+    }
+    return out;
+  }
+
+  // 只尝试一次，返回是否读到一致的快照
+  bool try_load(T &out) const {
+    const uint64_t s1 = seq_.load(std::memory_order_acquire);
+    if (s1 & 1U)
+      return false;
+    uint64_t buf[kWords];
+    for (size_t i = 0; i < kWords; ++i)
+      buf[i] = words_[i].load(std::memory_order_relaxed);
+    // 保证数据的读取不会被重排到第二次读 seq 之后
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t s2 = seq_.load(std::memory_order_relaxed);
+    if (s1 != s2)
+      return false;
+    std::memcpy(&out, buf, sizeof(T));
+    return true;
+  }
+
+  // 写：整体替换
+  void store(const T &value) {
+    write([&](T &v) { v = value; });
+  }
+
+  // 写：读-改-写，fn 接收当前值的引用并修改它
+  template <typename Fn> void write(Fn &&fn) {
+    const uint64_t s = begin_write();
+    // 写者持有奇数序号时数据不会被其他写者修改，可以直接读出旧值
+    uint64_t buf[kWords];
+    for (size_t i = 0; i < kWords; ++i)
+      buf[i] = words_[i].load(std::memory_order_relaxed);
+    T value;
+    std::memcpy(&value, buf, sizeof(T));
+    fn(value);
+    store_words(value);
+    // 数据写完后再让 seq 变回偶数
+    seq_.store(s + 2, std::memory_order_release);
+  }
+
+  // 当前序号，可用来观察写入次数（每次写 +2）
+  uint64_t sequence() const { return seq_.load(std::memory_order_acquire); }
+
+private:
+  static constexpr size_t kWords =
+      (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+  // 抢到一个偶数序号并置为奇数，返回原来的偶数序号
+  uint64_t begin_write() {
+    uint64_t s = seq_.load(std::memory_order_relaxed);
+    while (true) {
+      if (!(s & 1U) &&
+          seq_.compare_exchange_weak(s, s + 1, std::memory_order_relaxed)) {
+        break;
+      }
+      s = seq_.load(std::memory_order_relaxed);
+    }
+    // 序号变奇数之后才能开始写数据
+    std::atomic_thread_fence(std::memory_order_release);
+    return s;
+  }
+
+  void store_words(const T &value) {
+    uint64_t buf[kWords] = {};
+    std::memcpy(buf, &value, sizeof(T));
+    for (size_t i = 0; i < kWords; ++i)
+      words_[i].store(buf[i], std::memory_order_relaxed);
+  }
+
+  // seq 与数据对齐到同一条缓存行的开头，读者一次就能取到两者
+  alignas(64) std::atomic<uint64_t> seq_{0};
+  std::atomic<uint64_t> words_[kWords];
+};
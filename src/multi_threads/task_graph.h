@@ -0,0 +1,548 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "thread_pool.h"
+
+/*
+任务 + Future 续体（continuation）+ 依赖图
+  m_thread.cpp 里的写法：result1.get() + result2.get()
+  调用线程会阻塞在 get() 上；如果这是线程池里的线程，它在等待期间什么也干不了，
+  扇出/扇入（fan-out / fan-in）的请求路径上，被阻塞的线程就是损失的吞吐。
+
+  这里的 Future 没有阻塞的 get()，而是"结果就绪之后要做什么"：
+    async(pool, f)        在线程池中执行 f，返回 Future
+    fut.then(g)           fut 就绪后，把 g(结果) 作为新任务投递到线程池
+    when_all(f1, f2, ...) 全部就绪后得到 tuple；when_all(vector) 得到 vector
+    when_any(vector)      任意一个就绪后得到 (下标, 结果)
+    TaskGraph             显式 DAG：某个节点的所有前驱完成后立即调度它
+  只有最外层（例如 main）可以用 sync_wait 等结果，线程池里的任务永远不阻塞。
+
+  共享状态（Future/Promise 之间的控制块）很小但数量多，
+  通过 PoolAllocator 从线程局部的空闲链表分配，避免每个任务一次 malloc。
+  续体和投递的任务仍然是 std::function：捕获超过两个指针时它在堆上分配，
+  std::function 不支持自定义分配器，这部分分配没有池化。
+*/
+namespace task {
+
+// ======================================================
+// 池分配器：每种类型一条线程局部空闲链表
+//   释放到"当前线程"的链表（跨线程释放的块会留在释放线程，下次复用），
+//   每条链表最多缓存 kMaxCached 块，多余的还给系统
+// ======================================================
+template <typename T> class PoolAllocator {
+public:
+  using value_type = T;
+
+  PoolAllocator() = default;
+  template <typename U> PoolAllocator(const PoolAllocator<U> &) noexcept {}
+
+  T *allocate(size_t n) {
+    if (n != 1)
+      return static_cast<T *>(::operator new(n * sizeof(T)));
+    FreeList &list = free_list();
+    if (list.head != nullptr) {
+      Block *b = list.head;
+      list.head = b->next;
+      --list.count;
+      return reinterpret_cast<T *>(b);
+    }
+    return static_cast<T *>(::operator new(sizeof(Slot)));
+  }
+
+  void deallocate(T *p, size_t n) noexcept {
+    if (n != 1) {
+      ::operator delete(p);
+      return;
+    }
+    FreeList &list = free_list();
+    if (list.count >= kMaxCached) {
+      ::operator delete(p);
+      return;
+    }
+    Block *b = reinterpret_cast<Block *>(p);
+    b->next = list.head;
+    list.head = b;
+    ++list.count;
+  }
+
+  template <typename U> bool operator==(const PoolAllocator<U> &) const {
+    return true;
+  }
+
+private:
+  static constexpr size_t kMaxCached = 4096;
+
+  struct Block {
+    Block *next;
+  };
+  // 保证空闲块既能放下 T，也能放下链表指针
+  union Slot {
+    Block block;
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+  struct FreeList {
+    Block *head = nullptr;
+    size_t count = 0;
+    ~FreeList() {
+      while (head != nullptr) {
+        Block *next = head->next;
+        ::operator delete(head);
+        head = next;
+      }
+    }
+  };
+
+  static FreeList &free_list() {
+    thread_local FreeList list;
+    return list;
+  }
+};
+
+// void 结果用 std::monostate 存放，统一处理
+template <typename T>
+using stored_t = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+// ======================================================
+// 共享状态：结果 / 异常 + 就绪后要执行的续体
+// ======================================================
+template <typename T> class SharedState {
+public:
+  using Stored = stored_t<T>;
+
+  explicit SharedState(ThreadPool &pool) : pool_(pool) {}
+
+  void set_value(Stored v) {
+    std::vector<std::function<void()>> conts;
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      if (ready_)
+        throw std::logic_error("promise already satisfied");
+      value_.emplace(std::move(v));
+      ready_ = true;
+      conts.swap(conts_);
+    }
+    for (auto &c : conts)
+      dispatch(c);
+  }
+
+  void set_exception(std::exception_ptr e) {
+    std::vector<std::function<void()>> conts;
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      if (ready_)
+        throw std::logic_error("promise already satisfied");
+      error_ = std::move(e);
+      ready_ = true;
+      conts.swap(conts_);
+    }
+    for (auto &c : conts)
+      dispatch(c);
+  }
+
+  // 已就绪则立即投递，否则登记，等 set_value 时投递
+  void on_ready(std::function<void()> f) {
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      if (!ready_) {
+        conts_.push_back(std::move(f));
+        return;
+      }
+    }
+    dispatch(f);
+  }
+
+  [[nodiscard]] bool ready() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return ready_;
+  }
+
+  // 以下三个函数只能在就绪之后（续体里）调用。
+  // 一个结果可以有多个消费者（同一个 Future 上多次 then、先 when_any 再 when_all），
+  // 它们可能同时在不同的工作线程上读，所以只给 const 引用：需要的消费者自己拷贝，谁都不能移走
+  [[nodiscard]] bool has_error() const { return error_ != nullptr; }
+  [[nodiscard]] std::exception_ptr error() const { return error_; }
+  [[nodiscard]] const Stored &value() const { return *value_; }
+
+  ThreadPool &pool() { return pool_; }
+
+private:
+  // 续体在状态切换（加锁的那一段）之外投递，所以投递失败不会留下"已就绪但续体丢了"的状态。
+  // 线程池已经开始析构时不再接受任务，这时直接在当前线程执行续体：
+  // 下游 Future 和 sync_wait 照样能完成，工作线程里也不会因为投递失败抛出异常
+  void dispatch(std::function<void()> &f) {
+    if (!pool_.try_post(f))
+      f();
+  }
+
+  ThreadPool &pool_;
+  mutable std::mutex mtx_;
+  bool ready_ = false;
+  std::optional<Stored> value_;
+  std::exception_ptr error_;
+  std::vector<std::function<void()>> conts_;
+};
+
+template <typename T>
+std::shared_ptr<SharedState<T>> make_state(ThreadPool &pool) {
+  return std::allocate_shared<SharedState<T>>(
+      PoolAllocator<SharedState<T>>(), pool);
+}
+
+template <typename T> class Future;
+
+// 运行 f(args...)，把结果或异常写入 state
+//   只有 f 本身的异常转成 set_exception；set_value 放在 try 外面，
+//   否则它里面的任何异常都会变成第二次 set_exception（"promise already satisfied"）
+template <typename R, typename F, typename... Args>
+void fulfill(SharedState<R> &state, F &f, Args &&...args) {
+  std::optional<stored_t<R>> result;
+  try {
+    if constexpr (std::is_void_v<R>) {
+      std::invoke(f, std::forward<Args>(args)...);
+      result.emplace();
+    } else {
+      result.emplace(std::invoke(f, std::forward<Args>(args)...));
+    }
+  } catch (...) {
+    state.set_exception(std::current_exception());
+    return;
+  }
+  state.set_value(std::move(*result));
+}
+
+template <typename T> class Promise {
+public:
+  explicit Promise(ThreadPool &pool) : state_(make_state<T>(pool)) {}
+
+  Future<T> get_future() { return Future<T>(state_); }
+
+  template <typename U = T>
+  std::enable_if_t<!std::is_void_v<U>> set_value(U value) {
+    state_->set_value(std::move(value));
+  }
+
+  template <typename U = T> std::enable_if_t<std::is_void_v<U>> set_value() {
+    state_->set_value(std::monostate{});
+  }
+
+  void set_exception(std::exception_ptr e) { state_->set_exception(e); }
+
+private:
+  std::shared_ptr<SharedState<T>> state_;
+};
+
+template <typename T> class Future {
+public:
+  Future() = default;
+  explicit Future(std::shared_ptr<SharedState<T>> state)
+      : state_(std::move(state)) {}
+
+  [[nodiscard]] bool valid() const { return state_ != nullptr; }
+  [[nodiscard]] bool ready() const { return state_->ready(); }
+
+  // 就绪后在线程池里执行 f(结果)（T 为 void 时执行 f()），返回 f 的结果的 Future；
+  // 上游出错时跳过 f，异常直接传给下游。
+  // f 拿到的是结果的 const 引用（按值接收时得到一份拷贝），同一个 Future 可以 then 多次
+  template <typename F> auto then(F f) {
+    using R = std::conditional_t<std::is_void_v<T>, std::invoke_result<F>,
+                                 std::invoke_result<F, std::add_lvalue_reference_t<const T>>>;
+    using Result = typename R::type;
+    auto next = make_state<Result>(state_->pool());
+    state_->on_ready([src = state_, next, f = std::move(f)]() mutable {
+      if (src->has_error()) {
+        next->set_exception(src->error());
+        return;
+      }
+      if constexpr (std::is_void_v<T>)
+        fulfill(*next, f);
+      else
+        fulfill(*next, f, src->value());
+    });
+    return Future<Result>(next);
+  }
+
+  // 注册一个只关心"完成"的回调（不论成功失败），供 when_all / when_any 使用
+  void on_ready(std::function<void()> f) { state_->on_ready(std::move(f)); }
+
+  std::shared_ptr<SharedState<T>> &state() { return state_; }
+
+private:
+  std::shared_ptr<SharedState<T>> state_;
+};
+
+// 在线程池中执行 f(args...)
+template <typename F, typename... Args>
+auto async(ThreadPool &pool, F f, Args... args) {
+  using R = std::invoke_result_t<F, Args...>;
+  auto state = make_state<R>(pool);
+  pool.post([state, f = std::move(f),
+             tup = std::make_tuple(std::move(args)...)]() mutable {
+    std::apply(
+        [&](auto &...a) { fulfill(*state, f, std::move(a)...); }, tup);
+  });
+  return Future<R>(state);
+}
+
+// 已经有值的 Future
+template <typename T> Future<T> make_ready_future(ThreadPool &pool, T value) {
+  auto state = make_state<T>(pool);
+  state->set_value(std::move(value));
+  return Future<T>(state);
+}
+
+// ======================================================
+// when_all：vector 版本
+// ======================================================
+template <typename T>
+Future<std::vector<T>> when_all(ThreadPool &pool, std::vector<Future<T>> futures) {
+  auto out = make_state<std::vector<T>>(pool);
+  if (futures.empty()) {
+    out->set_value({});
+    return Future<std::vector<T>>(out);
+  }
+  struct Join {
+    std::vector<std::optional<T>> results;
+    std::atomic<size_t> remaining;
+    std::atomic<bool> failed{false};
+    explicit Join(size_t n) : results(n), remaining(n) {}
+  };
+  auto join = std::allocate_shared<Join>(PoolAllocator<Join>(), futures.size());
+  for (size_t i = 0; i < futures.size(); ++i) {
+    auto src = futures[i].state();
+    src->on_ready([src, join, out, i] {
+      if (src->has_error()) {
+        // 第一个失败者负责传递异常，之后的结果全部丢弃
+        if (!join->failed.exchange(true))
+          out->set_exception(src->error());
+      } else {
+        join->results[i].emplace(src->value());
+      }
+      if (join->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1 &&
+          !join->failed.load()) {
+        std::vector<T> values;
+        values.reserve(join->results.size());
+        for (auto &r : join->results)
+          values.push_back(std::move(*r));
+        out->set_value(std::move(values));
+      }
+    });
+  }
+  return Future<std::vector<T>>(out);
+}
+
+// ======================================================
+// when_all：可变参数版本，结果是 tuple
+// ======================================================
+template <typename... Ts>
+Future<std::tuple<stored_t<Ts>...>> when_all(ThreadPool &pool,
+                                             Future<Ts>... futures) {
+  using Tuple = std::tuple<stored_t<Ts>...>;
+  auto out = make_state<Tuple>(pool);
+  struct Join {
+    std::tuple<std::optional<stored_t<Ts>>...> results;
+    std::atomic<size_t> remaining{sizeof...(Ts)};
+    std::atomic<bool> failed{false};
+  };
+  auto join = std::allocate_shared<Join>(PoolAllocator<Join>());
+
+  auto attach = [&]<size_t I, typename T>(std::integral_constant<size_t, I>,
+                                          Future<T> &f) {
+    auto src = f.state();
+    src->on_ready([src, join, out] {
+      if (src->has_error()) {
+        if (!join->failed.exchange(true))
+          out->set_exception(src->error());
+      } else {
+        std::get<I>(join->results).emplace(src->value());
+      }
+      if (join->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1 &&
+          !join->failed.load()) {
+        out->set_value(std::apply(
+            [](auto &...r) { return Tuple(std::move(*r)...); },
+            join->results));
+      }
+    });
+  };
+  [&]<size_t... Is>(std::index_sequence<Is...>) {
+    (attach(std::integral_constant<size_t, Is>{}, futures), ...);
+  }(std::index_sequence_for<Ts...>{});
+  return Future<Tuple>(out);
+}
+
+// ======================================================
+// when_any：第一个完成（成功或失败）的 Future 决定结果
+// ======================================================
+template <typename T>
+Future<std::pair<size_t, T>> when_any(ThreadPool &pool,
+                                      std::vector<Future<T>> futures) {
+  if (futures.empty())
+    throw std::invalid_argument("when_any on empty input");
+  auto out = make_state<std::pair<size_t, T>>(pool);
+  auto done = std::make_shared<std::atomic<bool>>(false);
+  for (size_t i = 0; i < futures.size(); ++i) {
+    auto src = futures[i].state();
+    src->on_ready([src, out, done, i] {
+      if (done->exchange(true))
+        return;
+      if (src->has_error())
+        out->set_exception(src->error());
+      else
+        out->set_value(std::make_pair(i, src->value()));
+    });
+  }
+  return Future<std::pair<size_t, T>>(out);
+}
+
+// 只在最外层（不在线程池的线程里）等待结果，例如 main 函数
+template <typename T> stored_t<T> sync_wait(Future<T> f) {
+  std::promise<stored_t<T>> done;
+  auto result = done.get_future();
+  auto src = f.state();
+  src->on_ready([src, &done] {
+    if (src->has_error())
+      done.set_exception(src->error());
+    else
+      done.set_value(src->value());
+  });
+  return result.get();
+}
+
+// ======================================================
+// TaskGraph：显式依赖 DAG
+//   emplace 添加节点，precede(a, b) 表示 a 完成后才能运行 b；
+//   run 时入度为 0 的节点先投递，每个节点完成后把后继的剩余入度减一，
+//   减到 0 的后继立即投递。某个节点抛异常时，它的所有下游都会被跳过，
+//   整张图的 Future 以第一个异常结束。
+//   run 返回的 Future 就绪之前，TaskGraph 对象必须保持存活。
+// ======================================================
+class TaskGraph {
+public:
+  using TaskId = size_t;
+
+  TaskId emplace(std::function<void()> fn) {
+    nodes_.emplace_back();
+    nodes_.back().fn = std::move(fn);
+    return nodes_.size() - 1;
+  }
+
+  void precede(TaskId before, TaskId after) {
+    if (before >= nodes_.size() || after >= nodes_.size())
+      throw std::out_of_range("TaskGraph: bad task id");
+    nodes_[before].successors.push_back(after);
+    ++nodes_[after].indegree;
+  }
+
+  [[nodiscard]] size_t size() const { return nodes_.size(); }
+
+  Future<void> run(ThreadPool &pool) {
+    check_acyclic();
+    done_ = make_state<void>(pool);
+    pool_ = &pool;
+    remaining_.store(nodes_.size());
+    firstError_ = nullptr;
+    errorTaken_.store(false);
+    if (nodes_.empty()) {
+      done_->set_value(std::monostate{});
+      return Future<void>(done_);
+    }
+    for (auto &n : nodes_) {
+      n.pending.store(n.indegree);
+      n.skipped.store(false);
+    }
+    for (TaskId i = 0; i < nodes_.size(); ++i)
+      if (nodes_[i].indegree == 0)
+        schedule(i);
+    return Future<void>(done_);
+  }
+
+private:
+  struct Node {
+    std::function<void()> fn;
+    std::vector<TaskId> successors;
+    size_t indegree = 0;
+    std::atomic<size_t> pending{0};
+    std::atomic<bool> skipped{false}; // 某个前驱失败，本节点不执行
+  };
+
+  // 线程池已经开始析构时在当前线程执行，与 SharedState 的续体一样
+  void schedule(TaskId id) {
+    std::function<void()> job = [this, id] { execute(id); };
+    if (!pool_->try_post(job))
+      job();
+  }
+
+  void execute(TaskId id) {
+    Node &n = nodes_[id];
+    bool ok = !n.skipped.load(std::memory_order_acquire);
+    if (ok) {
+      try {
+        n.fn();
+      } catch (...) {
+        ok = false;
+        if (!errorTaken_.exchange(true))
+          firstError_ = std::current_exception();
+      }
+    }
+    for (TaskId s : n.successors) {
+      if (!ok)
+        nodes_[s].skipped.store(true, std::memory_order_release);
+      if (nodes_[s].pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        schedule(s);
+    }
+    if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      if (firstError_)
+        done_->set_exception(firstError_);
+      else
+        done_->set_value(std::monostate{});
+    }
+  }
+
+  // Kahn 拓扑排序检查是否有环，有环则永远无法完成
+  void check_acyclic() const {
+    std::vector<size_t> indeg(nodes_.size());
+    std::vector<TaskId> ready;
+    for (TaskId i = 0; i < nodes_.size(); ++i) {
+      indeg[i] = nodes_[i].indegree;
+      if (indeg[i] == 0)
+        ready.push_back(i);
+    }
+    size_t visited = 0;
+    while (!ready.empty()) {
+      const TaskId id = ready.back();
+      ready.pop_back();
+      ++visited;
+      for (TaskId s : nodes_[id].successors)
+        if (--indeg[s] == 0)
+          ready.push_back(s);
+    }
+    if (visited != nodes_.size())
+      throw std::invalid_argument("TaskGraph contains a cycle");
+  }
+
+  // deque 扩容不移动已有元素，节点地址保持稳定
+  std::deque<Node> nodes_;
+  ThreadPool *pool_ = nullptr;
+  std::shared_ptr<SharedState<void>> done_;
+  std::atomic<size_t> remaining_{0};
+  std::exception_ptr firstError_;
+  std::atomic<bool> errorTaken_{false};
+};
+
+} // namespace task
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/*
+固定大小线程池
+  N 个工作线程 + 一个任务队列（mutex + condition_variable 保护），
+  submit() 把任意可调用对象包装成 packaged_task 放入队列，返回 future。
+  可选的 onStart 回调在每个工作线程启动时执行一次（例如绑核、分配本地内存，
+  见 cpu_topology.h）。
+
+与 m_thread.cpp 里每次 std::async / std::thread 新建线程相比：
+  线程只创建一次，任务提交只是一次入队 + notify，适合大量短任务。
+*/
+class ThreadPool {
+public:
+  explicit ThreadPool(size_t threads = std::thread::hardware_concurrency(),
+                      std::function<void(size_t)> onStart = nullptr) {
+    if (threads == 0)
+      threads = 1;
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+      workers_.emplace_back([this, i, onStart] {
+        index() = i;
+        if (onStart)
+          onStart(i);
+        worker_loop();
+      });
+    }
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // 析构：等队列中已提交的任务全部执行完再退出
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto &t : workers_)
+      t.join();
+  }
+
+  // 提交任务，返回 future 获取结果（异常也会通过 future 传回）
+  template <typename F, typename... Args>
+  auto submit(F &&f, Args &&...args)
+      -> std::future<std::invoke_result_t<F, Args...>> {
+    using R = std::invoke_result_t<F, Args...>;
+    auto task = std::make_shared<std::packaged_task<R()>>(
+        std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+    std::future<R> result = task->get_future();
+    post([task] { (*task)(); });
+    return result;
+  }
+
+  // 提交不需要返回值的任务，省掉 packaged_task / future 的开销
+  void post(std::function<void()> job) {
+    if (!try_post(job))
+      throw std::runtime_error("post on stopped ThreadPool");
+  }
+
+  // 同 post，但线程池已经开始析构时不抛异常，返回 false，job 原样留给调用者
+  bool try_post(std::function<void()> &job) {
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      if (stop_)
+        return false;
+      tasks_.push(std::move(job));
+    }
+    cv_.notify_one();
+    return true;
+  }
+
+  [[nodiscard]] size_t size() const { return workers_.size(); }
+
+  // 当前线程在所属线程池中的编号；不是工作线程时返回 SIZE_MAX
+  static size_t worker_index() { return index(); }
+
+private:
+  static size_t &index() {
+    thread_local size_t i = SIZE_MAX;
+    return i;
+  }
+
+  void worker_loop() {
+    while (true) {
+      std::function<void()> job;
+      {
+        std::unique_lock<std::mutex> lock(mtx_);
+        cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+        if (stop_ && tasks_.empty())
+          return;
+        job = std::move(tasks_.front());
+        tasks_.pop();
+      }
+      job();
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  std::queue<std::function<void()>> tasks_;
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  bool stop_ = false;
+};
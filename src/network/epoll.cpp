@@ -25,6 +25,10 @@
  *
  * 【适用场景】
  * 高并发的网络服务（如Web服务器、消息中间件、网关）、需要同时处理多个文件/管道I/O的场景。
+ *
+ * 【绑核】
+ * 事件循环线程长期独占一个核，进入 epoll_wait 循环之前把它绑到一个 CPU 上（最好与网卡中断在同一个 NUMA 节点），
+ * 避免被调度器迁移后缓存失效。用法：./epoll [cpu]，不给参数则不绑核。
  */
 #include <arpa/inet.h>
 #include <fcntl.h>
@@ -32,15 +36,18 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include <cstdlib>
 #include <iostream>
 #include <vector>
 
+#include "../multi_threads/cpu_topology.h"
+
 int setNonBlocking(int fd) {
   int flags = fcntl(fd, F_GETFL, 0);
   return fcntl(fd, F_SETFL, flags | O_NONBLOCK);
 }
 
-int main() {
+int main(int argc, char **argv) {
   // 1. 创建监听 socket
   int listenfd = socket(AF_INET, SOCK_STREAM, 0);
   // 设置为非阻塞
@@ -60,7 +67,14 @@ int main() {
   ev.events = EPOLLIN;
   ev.data.fd = listenfd;
   epoll_ctl(epfd, EPOLL_CTL_ADD, listenfd, &ev);
-  // 6. 事件循环
+  // 6. 事件循环：进入循环之前绑核
+  if (argc > 1) {
+    const int cpu = std::atoi(argv[1]);
+    if (pin_current_thread(cpu))
+      std::cout << "事件循环绑定到 CPU " << cpu << std::endl;
+    else
+      std::cerr << "绑定 CPU " << cpu << " 失败" << std::endl;
+  }
   std::vector<epoll_event> events(16);
   // 7. 等待事件
   while (true) {
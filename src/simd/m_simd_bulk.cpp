@@ -0,0 +1,145 @@
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <span>
+#include <string>
+
+#include "../STL/aligned_allocator.h"
+#include "../STL/templates_vector.h"
+#include "simd_bulk.h"
+
+/*
+Vector 上的 SIMD 批量操作
+  数据：1600 万个 float（64MB，远大于缓存，吞吐受内存带宽限制）
+  一、对齐：Vector（malloc）与 AlignedVector（64 字节对齐）的缓冲区地址
+  二、fill / copy / transform / find / count 的吞吐（GB/s，按读写的字节数计算）：
+      标量循环（同一个 Vector）、SIMD + malloc 缓冲区、SIMD + 对齐缓冲区，
+      以 memset / memcpy 作为内存带宽的参考
+*/
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kElements = 16 * 1024 * 1024;
+
+template <typename V> V make_vector(size_t n) {
+  V v(n);
+  for (size_t i = 0; i < n; ++i)
+    v.push_back(static_cast<float>(i % 1000));
+  return v;
+}
+
+// 重复执行 fn 若干次，返回 GB/s
+template <typename Fn> double gbps(size_t bytes, Fn &&fn) {
+  constexpr int kRepeat = 5;
+  const auto start = Clock::now();
+  for (int r = 0; r < kRepeat; ++r)
+    fn();
+  const double s = std::chrono::duration<double>(Clock::now() - start).count();
+  return static_cast<double>(bytes) * kRepeat / s / 1e9;
+}
+
+template <typename V> std::span<float> span_of(V &v) {
+  return std::span<float>(v.data(), v.size());
+}
+
+// 每个操作依次在 标量 / SIMD+malloc / SIMD+对齐 三种配置下跑
+template <typename Scalar, typename Simd>
+void row(const std::string &name, size_t bytes, Vector<float> &plainIn,
+         Vector<float> &plainOut, AlignedVector<float> &alignedIn,
+         AlignedVector<float> &alignedOut, Scalar scalar, Simd simd) {
+  const double a = gbps(bytes, [&] { scalar(span_of(plainIn), span_of(plainOut)); });
+  const double b = gbps(bytes, [&] { simd(span_of(plainIn), span_of(plainOut)); });
+  const double c = gbps(bytes, [&] { simd(span_of(alignedIn), span_of(alignedOut)); });
+  std::cout << name << "\t标量: " << a << "\tSIMD: " << b << "\tSIMD+对齐: " << c
+            << " GB/s" << std::endl;
+}
+
+int main() {
+  auto plainIn = make_vector<Vector<float>>(kElements);
+  auto plainOut = make_vector<Vector<float>>(kElements);
+  auto alignedIn = make_vector<AlignedVector<float>>(kElements);
+  auto alignedOut = make_vector<AlignedVector<float>>(kElements);
+
+  std::cout << "Vector 缓冲区地址 % 64 = "
+            << reinterpret_cast<uintptr_t>(plainIn.data()) % 64
+            << "，AlignedVector 缓冲区地址 % 64 = "
+            << reinterpret_cast<uintptr_t>(alignedIn.data()) % 64 << std::endl;
+  std::cout << "指令集: " << simd::isa_name(simd::active_isa()) << std::endl;
+
+  const size_t bytes = kElements * sizeof(float);
+  using Span = std::span<float>;
+
+  // 内存带宽参考
+  const double setBw = gbps(bytes, [&] { std::memset(alignedOut.data(), 0, bytes); });
+  const double cpyBw =
+      gbps(2 * bytes, [&] { std::memcpy(alignedOut.data(), alignedIn.data(), bytes); });
+  std::cout << "参考\tmemset: " << setBw << "\tmemcpy: " << cpyBw << " GB/s"
+            << std::endl;
+
+  row(
+      "fill", bytes, plainIn, plainOut, alignedIn, alignedOut,
+      [](Span, Span out) {
+        for (float &x : out)
+          x = 1.5f;
+      },
+      [](Span, Span out) { simd::fill(out, 1.5f); });
+
+  row(
+      "copy", 2 * bytes, plainIn, plainOut, alignedIn, alignedOut,
+      [](Span in, Span out) {
+        for (size_t i = 0; i < in.size(); ++i)
+          out[i] = in[i];
+      },
+      [](Span in, Span out) { simd::copy<float>(in, out); });
+
+  row(
+      "transform", 2 * bytes, plainIn, plainOut, alignedIn, alignedOut,
+      [](Span in, Span out) {
+        for (size_t i = 0; i < in.size(); ++i)
+          out[i] = in[i] * 2.0f;
+      },
+      [](Span in, Span out) {
+        simd::transform<float>(in, out, simd::Op::Mul, 2.0f);
+      });
+
+  // 查找一个不存在的值，必须扫完整个数组
+  volatile size_t found = 0;
+  row(
+      "find", bytes, plainIn, plainOut, alignedIn, alignedOut,
+      [&](Span in, Span) {
+        size_t i = 0;
+        while (i < in.size() && in[i] != -1.0f)
+          ++i;
+        found = i;
+      },
+      [&](Span in, Span) {
+        found = simd::find<float>(in, simd::Cmp::Equal, -1.0f);
+      });
+
+  volatile size_t counted = 0;
+  row(
+      "count", bytes, plainIn, plainOut, alignedIn, alignedOut,
+      [&](Span in, Span) {
+        size_t c = 0;
+        for (const float x : in)
+          c += x > 500.0f ? 1 : 0;
+        counted = c;
+      },
+      [&](Span in, Span) {
+        counted = simd::count_if<float>(in, simd::Cmp::Greater, 500.0f);
+      });
+
+  // 正确性：与标量结果比较
+  simd::transform<float>(span_of(alignedIn), span_of(alignedOut), simd::Op::Max,
+                         700.0f);
+  bool ok = simd::find<float>(span_of(alignedIn), simd::Cmp::Equal, 999.0f) == 999 &&
+            simd::find<float>(span_of(alignedIn), simd::Cmp::Equal, -1.0f) ==
+                kElements;
+  for (size_t i = 0; i < kElements && ok; ++i)
+    ok = alignedOut[static_cast<int>(i)] ==
+         (alignedIn[static_cast<int>(i)] > 700.0f ? alignedIn[static_cast<int>(i)]
+                                                    : 700.0f);
+  std::cout << "结果与标量一致: " << std::boolalpha << ok << std::endl;
+  return 0;
+}
@@ -0,0 +1,167 @@
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "simd_reduce.h"
+
+/*
+SIMD 归约内核演示与基准
+  一、正确性：各指令集版本与标量版本结果一致
+  二、单核吞吐：各指令集版本 GB/s，对比 m_thread.cpp 里 int 累加的标量循环
+  三、多核：SIMD 内核 + 线程池分段归约
+*/
+
+// m_thread.cpp 中的写法：标量循环累加到 int（大数据量会溢出）
+int naive_sum(const int32_t *p, size_t n) {
+  int result = 0;
+  for (size_t i = 0; i < n; ++i)
+    result += p[i];
+  return result;
+}
+
+// 重复执行 fn 若干次，返回 GB/s
+template <typename Fn> double gbps(size_t bytes, Fn &&fn) {
+  constexpr int kRepeat = 5;
+  volatile double sink = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < kRepeat; ++r)
+    sink = sink + static_cast<double>(fn());
+  const double sec =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+          .count();
+  return static_cast<double>(bytes) * kRepeat / sec / 1e9;
+}
+
+std::vector<simd::Isa> available_isas() {
+  std::vector<simd::Isa> isas;
+  for (int i = 0; i <= static_cast<int>(simd::detect_isa()); ++i)
+    isas.push_back(static_cast<simd::Isa>(i));
+  return isas;
+}
+
+template <typename T> std::vector<T> random_data(size_t n) {
+  std::mt19937 rng(42);
+  std::vector<T> v(n);
+  for (auto &x : v) {
+    if constexpr (std::is_integral_v<T>)
+      x = static_cast<T>(rng() % 2001) - 1000;
+    else
+      x = static_cast<T>(static_cast<int>(rng() % 2001) - 1000) / 8;
+  }
+  return v;
+}
+
+// 一、校验各个指令集版本与标量版本一致
+template <typename T> bool verify(const char *name) {
+  // 长度取奇数，覆盖尾部处理
+  const auto data = random_data<T>(100003);
+  const auto other = random_data<T>(100003);
+  std::span<const T> s(data), o(other);
+
+  simd::set_isa(simd::Isa::Scalar);
+  const auto refSum = simd::sum(s);
+  const auto refDot = simd::dot(s, o);
+  const T refMin = simd::min(s), refMax = simd::max(s);
+  const size_t refCnt = simd::count_if(s, simd::Cmp::Greater, T{100});
+  std::vector<T> refPrefix(data.size());
+  simd::prefix_sum(s, std::span<T>(refPrefix));
+
+  bool ok = true;
+  for (simd::Isa isa : available_isas()) {
+    simd::set_isa(isa);
+    std::vector<T> prefix(data.size());
+    simd::prefix_sum(s, std::span<T>(prefix));
+    // 数据都是 1/8 的整数倍，浮点求和在这个范围内是精确的
+    const bool same = simd::sum(s) == refSum && simd::dot(s, o) == refDot &&
+                      simd::min(s) == refMin && simd::max(s) == refMax &&
+                      simd::count_if(s, simd::Cmp::Greater, T{100}) == refCnt &&
+                      prefix == refPrefix;
+    if (!same) {
+      std::cout << "  " << name << " @" << simd::isa_name(isa) << " 结果不一致!"
+                << std::endl;
+      ok = false;
+    }
+  }
+  simd::set_isa(simd::detect_isa());
+  return ok;
+}
+
+// 二、单核吞吐
+template <typename T> void bench(const char *name, size_t n) {
+  const auto data = random_data<T>(n);
+  const auto other = random_data<T>(n);
+  std::vector<T> out(n);
+  std::span<const T> s(data), o(other);
+  const size_t bytes = n * sizeof(T);
+
+  std::cout << "\n[" << name << "] " << n << " 个元素 (GB/s)\n";
+  std::cout << "isa\tsum\tdot\tmin\tcount_if\tprefix_sum\n";
+  for (simd::Isa isa : available_isas()) {
+    simd::set_isa(isa);
+    std::cout << simd::isa_name(isa) << "\t"
+              << gbps(bytes, [&] { return simd::sum(s); }) << "\t"
+              << gbps(2 * bytes, [&] { return simd::dot(s, o); }) << "\t"
+              << gbps(bytes, [&] { return simd::min(s); }) << "\t"
+              << gbps(bytes,
+                      [&] { return simd::count_if(s, simd::Cmp::Less, T{0}); })
+              << "\t\t" << gbps(2 * bytes, [&] {
+                   simd::prefix_sum(s, std::span<T>(out));
+                   return out.back();
+                 })
+              << std::endl;
+  }
+  simd::set_isa(simd::detect_isa());
+}
+
+int main() {
+  std::cout << "检测到的指令集: " << simd::isa_name(simd::detect_isa())
+            << std::endl;
+
+  // 一、正确性
+  const bool ok = verify<int32_t>("int32") && verify<int64_t>("int64") &&
+                  verify<float>("float") && verify<double>("double");
+  std::cout << "正确性校验: " << (ok ? "通过" : "失败") << std::endl;
+
+  // int 累加溢出演示：2^20 个 4096，总和 2^32 超出 int 范围
+  std::vector<int32_t> big(1 << 20, 4096);
+  std::cout << "int 累加: " << naive_sum(big.data(), big.size())
+            << "，simd::sum: " << simd::sum(std::span<const int32_t>(big))
+            << std::endl;
+
+  // 二、单核吞吐
+  const size_t n = 1 << 22;
+  {
+    const auto data = random_data<int32_t>(n);
+    std::cout << "\n标量 int 循环 (m_thread.cpp 写法): "
+              << gbps(n * sizeof(int32_t),
+                      [&] { return naive_sum(data.data(), data.size()); })
+              << " GB/s" << std::endl;
+  }
+  bench<int32_t>("int32", n);
+  bench<int64_t>("int64", n);
+  bench<float>("float", n);
+  bench<double>("double", n);
+
+  // 三、多核归约
+  ThreadPool pool;
+  const auto data = random_data<float>(n * 4);
+  std::span<const float> s(data);
+  std::cout << "\n多核 (" << pool.size() << " 线程) float sum: "
+            << gbps(s.size_bytes(), [&] { return simd::parallel_sum(pool, s); })
+            << " GB/s，单核: " << gbps(s.size_bytes(), [&] {
+                 return simd::sum(s);
+               })
+            << " GB/s" << std::endl;
+  std::cout << "parallel_sum = " << simd::parallel_sum(pool, s)
+            << "，sum = " << simd::sum(s)
+            << "，parallel_min = " << simd::parallel_min(pool, s)
+            << "，parallel_count_if(>0) = "
+            << simd::parallel_count_if(pool, s, simd::Cmp::Greater, 0.0f)
+            << std::endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,267 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+
+#include "simd_reduce.h"
+
+/*
+SIMD 批量操作（与 simd_reduce.h 共用 CPU 检测、指令集选择和向量类型）
+  fill       out[i] = value
+  copy       out[i] = in[i]
+  transform  out[i] = in[i] <op> value，op 为 Add / Sub / Mul / Min / Max
+  find       第一个满足 x <cmp> value 的下标，没有则返回 size()
+  count      直接用 simd_reduce.h 的 count_if
+  支持的类型：int32_t / int64_t / float / double
+
+这些操作每个元素只做一两条指令，瓶颈在内存带宽：缓冲区按 64 字节（缓存行）对齐时，
+AVX 的 32 字节 / AVX-512 的 64 字节访存不会跨缓存行（见 STL/aligned_allocator.h）。
+内核用的是非对齐 load/store，任意地址都正确，只是对齐时更快。
+*/
+namespace simd {
+
+// transform 支持的运算
+enum class Op { Add, Sub, Mul, Min, Max };
+
+namespace detail {
+
+#define SIMD_INLINE inline __attribute__((always_inline))
+
+// ======================================================
+// 标量参考实现（也是各向量内核的尾部处理）
+// ======================================================
+template <typename T> SIMD_INLINE void fill_scalar(T *out, size_t n, T v) {
+  for (size_t i = 0; i < n; ++i)
+    out[i] = v;
+}
+
+template <typename T>
+SIMD_INLINE void copy_scalar(const T *in, T *out, size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    out[i] = in[i];
+}
+
+// 标量和向量共用：x、v 可以是 T，也可以是向量；结果写回 x
+// （不按值返回向量，避免默认指令集下按值传递 AVX 向量带来的 ABI 问题）
+template <Op O, typename X> SIMD_INLINE void apply(X &x, const X &v) {
+  if constexpr (O == Op::Add)
+    x += v;
+  else if constexpr (O == Op::Sub)
+    x -= v;
+  else if constexpr (O == Op::Mul)
+    x *= v;
+  else if constexpr (O == Op::Min)
+    x = x < v ? x : v;
+  else
+    x = x > v ? x : v;
+}
+
+template <Op O, typename T>
+SIMD_INLINE void transform_scalar(const T *in, T *out, size_t n, T v) {
+  for (size_t i = 0; i < n; ++i) {
+    T x = in[i];
+    apply<O>(x, v);
+    out[i] = x;
+  }
+}
+
+template <Cmp C, typename T>
+SIMD_INLINE size_t find_scalar(const T *p, size_t n, T v) {
+  for (size_t i = 0; i < n; ++i)
+    if (compare<C>(p[i], v))
+      return i;
+  return n;
+}
+
+#if SIMD_X86
+// ======================================================
+// 向量内核：W 为向量字节数
+// ======================================================
+template <int W, typename T>
+SIMD_INLINE void fill_kernel(T *out, size_t n, T value) {
+  constexpr int L = W / sizeof(T);
+  using V = Vec<T, W>;
+  const V v = V{} + value;
+  size_t i = 0;
+  for (; i + L <= n; i += L)
+    store<T, W>(out + i) = v;
+  fill_scalar(out + i, n - i, value);
+}
+
+template <int W, typename T>
+SIMD_INLINE void copy_kernel(const T *in, T *out, size_t n) {
+  constexpr int L = W / sizeof(T);
+  size_t i = 0;
+  // 一次搬两个向量，先都读进寄存器再写，减少读写交替
+  for (; i + 2 * L <= n; i += 2 * L) {
+    const Vec<T, W> a = load<T, W>(in + i);
+    const Vec<T, W> b = load<T, W>(in + i + L);
+    store<T, W>(out + i) = a;
+    store<T, W>(out + i + L) = b;
+  }
+  copy_scalar(in + i, out + i, n - i);
+}
+
+template <int W, Op O, typename T>
+SIMD_INLINE void transform_kernel(const T *in, T *out, size_t n, T value) {
+  constexpr int L = W / sizeof(T);
+  using V = Vec<T, W>;
+  const V v = V{} + value;
+  size_t i = 0;
+  for (; i + L <= n; i += L) {
+    V x = load<T, W>(in + i);
+    apply<O>(x, v);
+    store<T, W>(out + i) = x;
+  }
+  transform_scalar<O>(in + i, out + i, n - i, value);
+}
+
+// 一次比较 4 个向量，把比较结果按位或起来判断有没有命中；命中了再逐个 lane 找下标
+template <int W, Cmp C, typename T>
+SIMD_INLINE size_t find_kernel(const T *p, size_t n, T value) {
+  constexpr int L = W / sizeof(T);
+  constexpr int kUnroll = 4;
+  using V = Vec<T, W>;
+  using M = Vec<mask_elem_t<T>, W>;
+  using Bits = Vec<int64_t, W>;
+  const V v = V{} + value;
+  size_t i = 0;
+  for (; i + kUnroll * L <= n; i += kUnroll * L) {
+    M any = {};
+    for (int u = 0; u < kUnroll; ++u) {
+      const V x = load<T, W>(p + i + u * L);
+      if constexpr (C == Cmp::Less)
+        any |= x < v;
+      else if constexpr (C == Cmp::LessEqual)
+        any |= x <= v;
+      else if constexpr (C == Cmp::Greater)
+        any |= x > v;
+      else if constexpr (C == Cmp::GreaterEqual)
+        any |= x >= v;
+      else if constexpr (C == Cmp::Equal)
+        any |= x == v;
+      else
+        any |= x != v;
+    }
+    const Bits bits = reinterpret_cast<Bits>(any);
+    int64_t hit = 0;
+    for (int k = 0; k < W / 8; ++k)
+      hit |= bits[k];
+    if (hit != 0)
+      return i + find_scalar<C>(p + i, kUnroll * L, value);
+  }
+  return i + find_scalar<C>(p + i, n - i, value);
+}
+#endif // SIMD_X86
+
+// ======================================================
+// 分派表
+// ======================================================
+template <typename T> struct BulkKernels {
+  void (*fill)(T *, size_t, T);
+  void (*copy)(const T *, T *, size_t);
+  void (*transform[5])(const T *, T *, size_t, T);
+  size_t (*find[6])(const T *, size_t, T);
+};
+
+template <typename T> struct ScalarBulk {
+  static void fill(T *out, size_t n, T v) { fill_scalar(out, n, v); }
+  static void copy(const T *in, T *out, size_t n) { copy_scalar(in, out, n); }
+  template <Op O> static void transform(const T *in, T *out, size_t n, T v) {
+    transform_scalar<O>(in, out, n, v);
+  }
+  template <Cmp C> static size_t find(const T *p, size_t n, T v) {
+    return find_scalar<C>(p, n, v);
+  }
+};
+
+#if SIMD_X86
+#define SIMD_DEFINE_BULK(Name, Target, W)                                      \
+  template <typename T> struct Name {                                          \
+    __attribute__((target(Target))) static void fill(T *out, size_t n, T v) {  \
+      fill_kernel<W>(out, n, v);                                               \
+    }                                                                          \
+    __attribute__((target(Target))) static void copy(const T *in, T *out,      \
+                                                     size_t n) {               \
+      copy_kernel<W>(in, out, n);                                              \
+    }                                                                          \
+    template <Op O>                                                            \
+    __attribute__((target(Target))) static void transform(const T *in, T *out, \
+                                                          size_t n, T v) {     \
+      transform_kernel<W, O>(in, out, n, v);                                   \
+    }                                                                          \
+    template <Cmp C>                                                           \
+    __attribute__((target(Target))) static size_t find(const T *p, size_t n,   \
+                                                       T v) {                  \
+      return find_kernel<W, C>(p, n, v);                                       \
+    }                                                                          \
+  };
+
+SIMD_DEFINE_BULK(Sse2Bulk, "sse2", 16)
+SIMD_DEFINE_BULK(Avx2Bulk, "avx2", 32)
+SIMD_DEFINE_BULK(Avx512Bulk, "avx512f", 64)
+#undef SIMD_DEFINE_BULK
+#endif // SIMD_X86
+
+template <template <typename> class K, typename T>
+constexpr BulkKernels<T> make_bulk() {
+  return BulkKernels<T>{&K<T>::fill,
+                        &K<T>::copy,
+                        {&K<T>::template transform<Op::Add>,
+                         &K<T>::template transform<Op::Sub>,
+                         &K<T>::template transform<Op::Mul>,
+                         &K<T>::template transform<Op::Min>,
+                         &K<T>::template transform<Op::Max>},
+                        {&K<T>::template find<Cmp::Less>,
+                         &K<T>::template find<Cmp::LessEqual>,
+                         &K<T>::template find<Cmp::Greater>,
+                         &K<T>::template find<Cmp::GreaterEqual>,
+                         &K<T>::template find<Cmp::Equal>,
+                         &K<T>::template find<Cmp::NotEqual>}};
+}
+
+template <typename T> const BulkKernels<T> &bulk_for(Isa isa) {
+  static const BulkKernels<T> table[] = {
+      make_bulk<ScalarBulk, T>(),
+#if SIMD_X86
+      make_bulk<Sse2Bulk, T>(),
+      make_bulk<Avx2Bulk, T>(),
+      make_bulk<Avx512Bulk, T>(),
+#endif
+  };
+  return table[static_cast<int>(isa)];
+}
+
+#undef SIMD_INLINE
+} // namespace detail
+
+// ======================================================
+// 对外接口：std::span 入参，按 active_isa() 选择内核
+// ======================================================
+template <typename T> void fill(std::span<T> out, T value) {
+  detail::bulk_for<T>(active_isa()).fill(out.data(), out.size(), value);
+}
+
+template <typename T> void copy(std::span<const T> in, std::span<T> out) {
+  if (in.size() != out.size())
+    throw std::invalid_argument("simd::copy size mismatch");
+  detail::bulk_for<T>(active_isa()).copy(in.data(), out.data(), in.size());
+}
+
+// in 与 out 可以是同一块内存（原地变换）
+template <typename T>
+void transform(std::span<const T> in, std::span<T> out, Op op, T value) {
+  if (in.size() != out.size())
+    throw std::invalid_argument("simd::transform size mismatch");
+  detail::bulk_for<T>(active_isa())
+      .transform[static_cast<int>(op)](in.data(), out.data(), in.size(), value);
+}
+
+template <typename T> size_t find(std::span<const T> data, Cmp op, T value) {
+  return detail::bulk_for<T>(active_isa())
+      .find[static_cast<int>(op)](data.data(), data.size(), value);
+}
+
+} // namespace simd
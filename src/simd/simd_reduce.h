@@ -0,0 +1,542 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../multi_threads/thread_pool.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#define SIMD_X86 1
+#else
+#define SIMD_X86 0
+#endif
+
+/*
+SIMD 归约内核库（运行时 CPU 分派）
+  支持的操作：sum / min / max / dot / count_if / prefix_sum
+  支持的类型：int32_t / int64_t / float / double
+
+实现思路：
+  1. 每个内核只写一份模板，向量宽度 W（16/32/64 字节）作为模板参数，
+     用 GCC 向量扩展（vector_size）表达"一次处理 W 字节"的运算；
+  2. 再用 __attribute__((target("avx2"))) 等包装函数把同一份模板分别编译成
+     SSE2 / AVX2 / AVX-512 三个版本（模板是 always_inline，会被内联进包装函数，
+     于是按包装函数的指令集生成代码）；
+  3. 程序启动时用 cpuid + xgetbv 检测 CPU 和操作系统支持的最高指令集，
+     之后通过函数指针表调用对应版本；非 x86 平台只有标量版本。
+
+累加类型会加宽：int32 -> int64，float -> double，避免 m_thread.cpp 里
+sum() 用 int 累加溢出的问题；int64 / double 保持原类型。
+*/
+namespace simd {
+
+enum class Isa { Scalar = 0, SSE2 = 1, AVX2 = 2, AVX512 = 3 };
+
+inline const char *isa_name(Isa isa) {
+  switch (isa) {
+  case Isa::Scalar:
+    return "scalar";
+  case Isa::SSE2:
+    return "sse2";
+  case Isa::AVX2:
+    return "avx2";
+  case Isa::AVX512:
+    return "avx512";
+  }
+  return "unknown";
+}
+
+// count_if 支持的比较谓词：统计满足 x <op> value 的元素个数
+enum class Cmp { Less, LessEqual, Greater, GreaterEqual, Equal, NotEqual };
+
+// 累加类型
+template <typename T> struct Accum {
+  using type = T;
+};
+template <> struct Accum<int32_t> {
+  using type = int64_t;
+};
+template <> struct Accum<float> {
+  using type = double;
+};
+template <typename T> using accum_t = typename Accum<T>::type;
+
+// ======================================================
+// CPU 检测：cpuid 查询 CPU 能力，xgetbv 查询操作系统是否保存了 ymm/zmm 寄存器
+// ======================================================
+inline Isa detect_isa() {
+#if SIMD_X86
+  unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    return Isa::Scalar;
+  if (!(edx & bit_SSE2))
+    return Isa::Scalar;
+  Isa best = Isa::SSE2;
+
+  const bool osxsave = ecx & bit_OSXSAVE;
+  const bool avx = ecx & bit_AVX;
+  if (!osxsave || !avx)
+    return best;
+
+  unsigned xcr0_lo = 0, xcr0_hi = 0;
+  __asm__ volatile("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+  // bit1 SSE、bit2 AVX 状态；bit5~7 为 AVX-512 的 opmask/zmm 状态
+  const bool osAvx = (xcr0_lo & 0x6U) == 0x6U;
+  const bool osAvx512 = (xcr0_lo & 0xE6U) == 0xE6U;
+
+  if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+    return best;
+  if (osAvx && (ebx & bit_AVX2))
+    best = Isa::AVX2;
+  if (osAvx512 && (ebx & bit_AVX512F))
+    best = Isa::AVX512;
+  return best;
+#else
+  return Isa::Scalar;
+#endif
+}
+
+namespace detail {
+
+#define SIMD_INLINE inline __attribute__((always_inline))
+
+// ======================================================
+// 标量参考实现（也是各向量内核的尾部处理）
+// ======================================================
+template <typename T>
+SIMD_INLINE accum_t<T> sum_scalar(const T *p, size_t n) {
+  accum_t<T> r = 0;
+  for (size_t i = 0; i < n; ++i)
+    r += p[i];
+  return r;
+}
+
+template <typename T>
+SIMD_INLINE accum_t<T> dot_scalar(const T *a, const T *b, size_t n) {
+  accum_t<T> r = 0;
+  for (size_t i = 0; i < n; ++i)
+    r += static_cast<accum_t<T>>(a[i]) * static_cast<accum_t<T>>(b[i]);
+  return r;
+}
+
+template <typename T> SIMD_INLINE T min_scalar(const T *p, size_t n, T init) {
+  T m = init;
+  for (size_t i = 0; i < n; ++i)
+    m = p[i] < m ? p[i] : m;
+  return m;
+}
+
+template <typename T> SIMD_INLINE T max_scalar(const T *p, size_t n, T init) {
+  T m = init;
+  for (size_t i = 0; i < n; ++i)
+    m = p[i] > m ? p[i] : m;
+  return m;
+}
+
+template <Cmp C, typename T> SIMD_INLINE bool compare(T x, T v) {
+  if constexpr (C == Cmp::Less)
+    return x < v;
+  else if constexpr (C == Cmp::LessEqual)
+    return x <= v;
+  else if constexpr (C == Cmp::Greater)
+    return x > v;
+  else if constexpr (C == Cmp::GreaterEqual)
+    return x >= v;
+  else if constexpr (C == Cmp::Equal)
+    return x == v;
+  else
+    return x != v;
+}
+
+template <Cmp C, typename T>
+SIMD_INLINE size_t count_scalar(const T *p, size_t n, T v) {
+  size_t c = 0;
+  for (size_t i = 0; i < n; ++i)
+    c += compare<C>(p[i], v) ? 1 : 0;
+  return c;
+}
+
+// 返回最后一个前缀和，作为下一段的进位
+template <typename T>
+SIMD_INLINE T prefix_scalar(const T *in, T *out, size_t n, T carry) {
+  for (size_t i = 0; i < n; ++i) {
+    carry += in[i];
+    out[i] = carry;
+  }
+  return carry;
+}
+
+#if SIMD_X86
+// ======================================================
+// 向量类型：Vec 为对齐向量，UVec 为允许非对齐访问的向量（用于 load/store）
+// ======================================================
+template <typename T, int Bytes> struct VecOf {
+  typedef T type __attribute__((vector_size(Bytes)));
+  typedef T utype
+      __attribute__((vector_size(Bytes), aligned(sizeof(T)), may_alias));
+};
+template <typename T, int Bytes> using Vec = typename VecOf<T, Bytes>::type;
+template <typename T, int Bytes> using UVec = typename VecOf<T, Bytes>::utype;
+
+// 与 T 同宽的整数，用作比较结果与 shuffle 掩码的元素类型
+template <typename T>
+using mask_elem_t = std::conditional_t<sizeof(T) == 4, int32_t, int64_t>;
+
+// 把任意地址看成一个非对齐向量；返回引用而不是按值返回向量，
+// 避免默认指令集下按值传递 AVX 向量带来的 ABI 问题
+template <typename T, int Bytes>
+SIMD_INLINE const UVec<T, Bytes> &load(const T *p) {
+  return *reinterpret_cast<const UVec<T, Bytes> *>(p);
+}
+
+template <typename T, int Bytes> SIMD_INLINE UVec<T, Bytes> &store(T *p) {
+  return *reinterpret_cast<UVec<T, Bytes> *>(p);
+}
+
+// ======================================================
+// 向量内核：W 为向量字节数
+// ======================================================
+template <int W, typename T>
+SIMD_INLINE accum_t<T> sum_kernel(const T *p, size_t n) {
+  using A = accum_t<T>;
+  constexpr int L = W / sizeof(A); // 每次处理的元素个数（按累加类型计算）
+  using VA = Vec<A, W>;
+  // 两组累加器交替使用，打断加法的依赖链
+  VA acc0 = {}, acc1 = {};
+  size_t i = 0;
+  for (; i + 2 * L <= n; i += 2 * L) {
+    acc0 += __builtin_convertvector(load<T, L * sizeof(T)>(p + i), VA);
+    acc1 += __builtin_convertvector(load<T, L * sizeof(T)>(p + i + L), VA);
+  }
+  acc0 += acc1;
+  A r = 0;
+  for (int k = 0; k < L; ++k)
+    r += acc0[k];
+  return r + sum_scalar(p + i, n - i);
+}
+
+template <int W, typename T>
+SIMD_INLINE accum_t<T> dot_kernel(const T *a, const T *b, size_t n) {
+  using A = accum_t<T>;
+  constexpr int L = W / sizeof(A);
+  using VA = Vec<A, W>;
+  VA acc = {};
+  size_t i = 0;
+  for (; i + L <= n; i += L) {
+    const VA x = __builtin_convertvector(load<T, L * sizeof(T)>(a + i), VA);
+    const VA y = __builtin_convertvector(load<T, L * sizeof(T)>(b + i), VA);
+    acc += x * y;
+  }
+  A r = 0;
+  for (int k = 0; k < L; ++k)
+    r += acc[k];
+  return r + dot_scalar(a + i, b + i, n - i);
+}
+
+template <int W, bool IsMin, typename T>
+SIMD_INLINE T minmax_kernel(const T *p, size_t n) {
+  constexpr int L = W / sizeof(T);
+  using V = Vec<T, W>;
+  if (n < static_cast<size_t>(L))
+    return IsMin ? min_scalar(p + 1, n - 1, p[0]) : max_scalar(p + 1, n - 1, p[0]);
+  V m = load<T, W>(p);
+  size_t i = L;
+  for (; i + L <= n; i += L) {
+    const V x = load<T, W>(p + i);
+    if constexpr (IsMin)
+      m = x < m ? x : m;
+    else
+      m = x > m ? x : m;
+  }
+  T r = m[0];
+  for (int k = 1; k < L; ++k) {
+    if constexpr (IsMin)
+      r = m[k] < r ? m[k] : r;
+    else
+      r = m[k] > r ? m[k] : r;
+  }
+  return IsMin ? min_scalar(p + i, n - i, r) : max_scalar(p + i, n - i, r);
+}
+
+template <int W, Cmp C, typename T>
+SIMD_INLINE size_t count_kernel(const T *p, size_t n, T value) {
+  constexpr int L = W / sizeof(T);
+  using V = Vec<T, W>;
+  using M = Vec<mask_elem_t<T>, W>;
+  const V v = V{} + value;
+  size_t total = 0;
+  size_t i = 0;
+  // 比较结果为 -1/0，按块累加后再汇总，块大小保证每个 lane 不会溢出
+  constexpr size_t kBlock = size_t{1} << 24;
+  while (i + L <= n) {
+    M acc = {};
+    const size_t blockEnd = std::min(n - (n - i) % L, i + kBlock * L);
+    for (; i < blockEnd; i += L) {
+      const V x = load<T, W>(p + i);
+      M hit;
+      if constexpr (C == Cmp::Less)
+        hit = x < v;
+      else if constexpr (C == Cmp::LessEqual)
+        hit = x <= v;
+      else if constexpr (C == Cmp::Greater)
+        hit = x > v;
+      else if constexpr (C == Cmp::GreaterEqual)
+        hit = x >= v;
+      else if constexpr (C == Cmp::Equal)
+        hit = x == v;
+      else
+        hit = x != v;
+      acc -= hit;
+    }
+    for (int k = 0; k < L; ++k)
+      total += static_cast<size_t>(acc[k]);
+  }
+  return total + count_scalar<C>(p + i, n - i, value);
+}
+
+// 向量内前缀和：log2(L) 轮"左移 s 个 lane 再相加"
+template <int W, typename T>
+SIMD_INLINE void prefix_kernel(const T *in, T *out, size_t n) {
+  constexpr int L = W / sizeof(T);
+  using V = Vec<T, W>;
+  using M = Vec<mask_elem_t<T>, W>;
+  // 预先生成每一轮的 shuffle 掩码：下标 >= L 表示取第二个向量（全 0）
+  M masks[8];
+  int rounds = 0;
+  for (int s = 1; s < L; s <<= 1, ++rounds) {
+    for (int k = 0; k < L; ++k)
+      masks[rounds][k] = k >= s ? k - s : L;
+  }
+  const V zero = {};
+  T carry = 0;
+  size_t i = 0;
+  for (; i + L <= n; i += L) {
+    V x = load<T, W>(in + i);
+    for (int r = 0; r < rounds; ++r)
+      x += __builtin_shuffle(x, zero, masks[r]);
+    x += carry;
+    store<T, W>(out + i) = x;
+    carry = x[L - 1];
+  }
+  prefix_scalar(in + i, out + i, n - i, carry);
+}
+
+#endif // SIMD_X86
+
+// ======================================================
+// 分派表：每种类型 × 每个指令集一张函数指针表
+// ======================================================
+template <typename T> struct Kernels {
+  accum_t<T> (*sum)(const T *, size_t);
+  accum_t<T> (*dot)(const T *, const T *, size_t);
+  T (*min)(const T *, size_t);
+  T (*max)(const T *, size_t);
+  size_t (*count[6])(const T *, size_t, T);
+  void (*prefix)(const T *, T *, size_t);
+};
+
+template <typename T> struct ScalarKernels {
+  static accum_t<T> sum(const T *p, size_t n) { return sum_scalar(p, n); }
+  static accum_t<T> dot(const T *a, const T *b, size_t n) {
+    return dot_scalar(a, b, n);
+  }
+  static T min(const T *p, size_t n) { return min_scalar(p + 1, n - 1, p[0]); }
+  static T max(const T *p, size_t n) { return max_scalar(p + 1, n - 1, p[0]); }
+  template <Cmp C> static size_t count(const T *p, size_t n, T v) {
+    return count_scalar<C>(p, n, v);
+  }
+  static void prefix(const T *in, T *out, size_t n) {
+    prefix_scalar(in, out, n, T{0});
+  }
+};
+
+#if SIMD_X86
+// 同一份模板按不同 target 各编译一遍
+#define SIMD_DEFINE_KERNELS(Name, Target, W)                                   \
+  template <typename T> struct Name {                                          \
+    __attribute__((target(Target))) static accum_t<T> sum(const T *p,          \
+                                                          size_t n) {          \
+      return sum_kernel<W>(p, n);                                              \
+    }                                                                          \
+    __attribute__((target(Target))) static accum_t<T> dot(const T *a,          \
+                                                          const T *b,          \
+                                                          size_t n) {          \
+      return dot_kernel<W>(a, b, n);                                           \
+    }                                                                          \
+    __attribute__((target(Target))) static T min(const T *p, size_t n) {       \
+      return minmax_kernel<W, true>(p, n);                                     \
+    }                                                                          \
+    __attribute__((target(Target))) static T max(const T *p, size_t n) {       \
+      return minmax_kernel<W, false>(p, n);                                    \
+    }                                                                          \
+    template <Cmp C>                                                           \
+    __attribute__((target(Target))) static size_t count(const T *p, size_t n,  \
+                                                        T v) {                 \
+      return count_kernel<W, C>(p, n, v);                                      \
+    }                                                                          \
+    __attribute__((target(Target))) static void prefix(const T *in, T *out,    \
+                                                       size_t n) {             \
+      prefix_kernel<W>(in, out, n);                                            \
+    }                                                                          \
+  };
+
+SIMD_DEFINE_KERNELS(Sse2Kernels, "sse2", 16)
+SIMD_DEFINE_KERNELS(Avx2Kernels, "avx2", 32)
+SIMD_DEFINE_KERNELS(Avx512Kernels, "avx512f", 64)
+#undef SIMD_DEFINE_KERNELS
+#endif // SIMD_X86
+
+template <template <typename> class K, typename T>
+constexpr Kernels<T> make_kernels() {
+  return Kernels<T>{&K<T>::sum,
+                    &K<T>::dot,
+                    &K<T>::min,
+                    &K<T>::max,
+                    {&K<T>::template count<Cmp::Less>,
+                     &K<T>::template count<Cmp::LessEqual>,
+                     &K<T>::template count<Cmp::Greater>,
+                     &K<T>::template count<Cmp::GreaterEqual>,
+                     &K<T>::template count<Cmp::Equal>,
+                     &K<T>::template count<Cmp::NotEqual>},
+                    &K<T>::prefix};
+}
+
+template <typename T> const Kernels<T> &kernels_for(Isa isa) {
+  static const Kernels<T> table[] = {
+      make_kernels<ScalarKernels, T>(),
+#if SIMD_X86
+      make_kernels<Sse2Kernels, T>(),
+      make_kernels<Avx2Kernels, T>(),
+      make_kernels<Avx512Kernels, T>(),
+#endif
+  };
+  return table[static_cast<int>(isa)];
+}
+
+// parallel_* 在线程池的工作线程上读它，set_isa 可能同时在别的线程写，所以是原子的；
+// 只是一个独立的开关，不需要和其他数据同步，relaxed 即可
+inline std::atomic<Isa> &current_isa() {
+  static std::atomic<Isa> isa{detect_isa()};
+  return isa;
+}
+
+#undef SIMD_INLINE
+} // namespace detail
+
+// 当前使用的指令集（默认是检测到的最高级别）
+inline Isa active_isa() {
+  return detail::current_isa().load(std::memory_order_relaxed);
+}
+
+// 强制使用某个指令集（不会超过 CPU 实际支持的级别），主要用于基准对比
+inline Isa set_isa(Isa isa) {
+  const Isa best = detect_isa();
+  const Isa chosen = isa > best ? best : isa;
+  detail::current_isa().store(chosen, std::memory_order_relaxed);
+  return chosen;
+}
+
+// ======================================================
+// 对外接口：std::span 入参
+// ======================================================
+template <typename T> accum_t<T> sum(std::span<const T> data) {
+  return detail::kernels_for<T>(active_isa()).sum(data.data(), data.size());
+}
+
+template <typename T> T min(std::span<const T> data) {
+  if (data.empty())
+    throw std::invalid_argument("simd::min on empty span");
+  return detail::kernels_for<T>(active_isa()).min(data.data(), data.size());
+}
+
+template <typename T> T max(std::span<const T> data) {
+  if (data.empty())
+    throw std::invalid_argument("simd::max on empty span");
+  return detail::kernels_for<T>(active_isa()).max(data.data(), data.size());
+}
+
+template <typename T> accum_t<T> dot(std::span<const T> a, std::span<const T> b) {
+  if (a.size() != b.size())
+    throw std::invalid_argument("simd::dot size mismatch");
+  return detail::kernels_for<T>(active_isa()).dot(a.data(), b.data(), a.size());
+}
+
+template <typename T> size_t count_if(std::span<const T> data, Cmp op, T value) {
+  return detail::kernels_for<T>(active_isa())
+      .count[static_cast<int>(op)](data.data(), data.size(), value);
+}
+
+// 包含式前缀和：out[i] = in[0] + ... + in[i]，in 与 out 可以是同一块内存
+template <typename T> void prefix_sum(std::span<const T> in, std::span<T> out) {
+  if (in.size() != out.size())
+    throw std::invalid_argument("simd::prefix_sum size mismatch");
+  detail::kernels_for<T>(active_isa()).prefix(in.data(), out.data(), in.size());
+}
+
+// ======================================================
+// 多核归约：把数据切成 pool.size() 段，每段在工作线程里跑 SIMD 内核，
+// 调用线程最后合并各段结果
+// ======================================================
+template <typename T, typename Part, typename Combine, typename R>
+R parallel_reduce(ThreadPool &pool, std::span<const T> data, Part part,
+                  Combine combine, R init) {
+  // 太小的数据切分没有意义，单段处理即可
+  constexpr size_t kMinChunk = 1 << 15;
+  const size_t chunks = std::max<size_t>(
+      1, std::min(pool.size(), data.size() / kMinChunk));
+  const size_t step = (data.size() + chunks - 1) / chunks;
+
+  std::vector<std::future<R>> parts;
+  parts.reserve(chunks);
+  for (size_t begin = 0; begin < data.size(); begin += step) {
+    const auto piece = data.subspan(begin, std::min(step, data.size() - begin));
+    parts.push_back(pool.submit([piece, part] { return part(piece); }));
+  }
+  R result = init;
+  for (auto &f : parts)
+    result = combine(result, f.get());
+  return result;
+}
+
+template <typename T>
+accum_t<T> parallel_sum(ThreadPool &pool, std::span<const T> data) {
+  return parallel_reduce(
+      pool, data, [](std::span<const T> s) { return sum(s); },
+      [](accum_t<T> a, accum_t<T> b) { return a + b; }, accum_t<T>{0});
+}
+
+template <typename T> T parallel_min(ThreadPool &pool, std::span<const T> data) {
+  if (data.empty())
+    throw std::invalid_argument("simd::parallel_min on empty span");
+  return parallel_reduce(
+      pool, data, [](std::span<const T> s) { return min(s); },
+      [](T a, T b) { return b < a ? b : a; }, data[0]);
+}
+
+template <typename T> T parallel_max(ThreadPool &pool, std::span<const T> data) {
+  if (data.empty())
+    throw std::invalid_argument("simd::parallel_max on empty span");
+  return parallel_reduce(
+      pool, data, [](std::span<const T> s) { return max(s); },
+      [](T a, T b) { return b > a ? b : a; }, data[0]);
+}
+
+template <typename T>
+size_t parallel_count_if(ThreadPool &pool, std::span<const T> data, Cmp op,
+                         T value) {
+  return parallel_reduce(
+      pool, data,
+      [op, value](std::span<const T> s) { return count_if(s, op, value); },
+      [](size_t a, size_t b) { return a + b; }, size_t{0});
+}
+
+} // namespace simd
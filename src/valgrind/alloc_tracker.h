@@ -0,0 +1,453 @@
+#pragma once
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <errno.h>
+#include <execinfo.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+内置的低开销分配追踪 / 泄漏报告
+  valgrind 要慢 20~50 倍，没法在接近生产的负载下跑；这里用采样换速度：
+
+  采样：每个线程维护一个"距离下次采样还剩多少字节"的计数器，每次分配减去 size，
+  减到 0 以下才采样，下一次的间隔按均值为 interval 的指数分布随机取（默认 512KB）。
+  所以绝大多数分配只多一次线程局部的减法；被采样的分配代表 max(size, interval) 字节。
+
+  采样到的分配：用 backtrace 抓调用栈，按调用栈哈希归到"调用点"，
+  记录该调用点累计分配（churn）与仍然存活（live）的估计字节数；
+  指针记在一张无锁的开放寻址表里（每个指针只探测同一条缓存行里的 8 个槽位），
+  free 时查表，命中才更新统计，未命中的 free 只是多读一条缓存行。
+
+  报告：按存活字节排序的 top-N（疑似泄漏）+ 按累计分配排序的 top-N（抖动热点）。
+  进程退出时自动打印；install_signal_handler(SIGUSR2) 后，kill -USR2 <pid> 也会打印。
+
+  用法：在一个 .cpp 里 #define ALLOC_TRACKER_HOOK 再包含本头文件，
+  就会替换 malloc / calloc / realloc / free、对齐分配 aligned_alloc / posix_memalign / memalign，
+  以及全局 operator new / delete（包括 std::align_val_t 的对齐版本）。
+  环境变量：ALLOC_TRACKER_SAMPLE=字节数（采样间隔），ALLOC_TRACKER_TOP=N，ALLOC_TRACKER=0 关闭。
+  注意：不要与 slab_allocator.h 的 SLAB_REPLACE_GLOBAL_NEW 同时使用。
+*/
+namespace alloctrack {
+
+constexpr int kDepth = 12;                 // 每个调用栈保存的帧数
+constexpr int kSkip = 2;                   // 跳过 record_alloc 和 malloc 自身
+constexpr size_t kSites = 4096;            // 调用点表大小（第 0 项收容溢出）
+constexpr size_t kSampleSlots = 1u << 16;  // 存活采样表大小
+
+struct Site {
+  std::atomic<uint64_t> hash{0};
+  void *frames[kDepth] = {};
+  int depth = 0;
+  std::atomic<int64_t> liveBytes{0};
+  std::atomic<int64_t> liveCount{0};
+  std::atomic<int64_t> allocBytes{0};
+  std::atomic<int64_t> allocCount{0};
+};
+
+namespace detail {
+
+struct SampleInfo {
+  uint32_t site;
+  int64_t weight;
+};
+
+inline Site sites[kSites];
+inline std::atomic<uintptr_t> sampleKeys[kSampleSlots];
+inline SampleInfo sampleInfo[kSampleSlots];
+inline std::atomic<int64_t> liveSamples{0};
+inline std::atomic<uint64_t> dropped{0};
+inline std::atomic<size_t> interval{512 * 1024};
+inline std::atomic<bool> enabled{true};
+inline size_t topN = 10;
+
+constexpr int64_t kUninit = INT64_MIN;
+inline thread_local int64_t untilSample = kUninit;
+inline thread_local bool inHook = false; // 防止追踪自身（backtrace、报告）里的分配
+inline thread_local uint64_t rng = 0;
+
+inline uint64_t mix(uint64_t x) {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  x ^= x >> 33;
+  return x;
+}
+
+// 均值为 mean 的指数分布
+inline int64_t next_interval(size_t mean) {
+  if (rng == 0)
+    rng = mix(reinterpret_cast<uintptr_t>(&rng)) | 1;
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  const double u = (static_cast<double>(rng >> 11) + 1.0) / 9007199254740993.0;
+  return static_cast<int64_t>(-std::log(u) * static_cast<double>(mean)) + 1;
+}
+
+inline uint32_t find_site(void **frames, int depth) {
+  uint64_t h = 1469598103934665603ULL;
+  for (int i = 0; i < depth; ++i)
+    h = mix(h ^ reinterpret_cast<uintptr_t>(frames[i]));
+  h |= 1; // 0 表示空槽
+  for (size_t probe = 0; probe < 64; ++probe) {
+    const size_t idx = 1 + (h + probe) % (kSites - 1);
+    Site &s = sites[idx];
+    uint64_t cur = s.hash.load(std::memory_order_acquire);
+    if (cur == h)
+      return static_cast<uint32_t>(idx);
+    if (cur == 0 && s.hash.compare_exchange_strong(cur, h)) {
+      std::memcpy(s.frames, frames, sizeof(void *) * depth);
+      s.depth = depth;
+      return static_cast<uint32_t>(idx);
+    }
+    if (cur == h)
+      return static_cast<uint32_t>(idx);
+  }
+  return 0; // 表满，记到"其他"
+}
+
+// 同一条缓存行里的 8 个槽位
+inline size_t window_of(const void *p) {
+  return mix(reinterpret_cast<uintptr_t>(p)) & (kSampleSlots - 1) & ~size_t{7};
+}
+
+__attribute__((noinline)) inline void record_alloc(void *p, size_t size) {
+  if (inHook || !enabled.load(std::memory_order_relaxed))
+    return;
+  int64_t &until = untilSample;
+  if (until == kUninit)
+    until = next_interval(interval.load(std::memory_order_relaxed));
+  until -= static_cast<int64_t>(size);
+  if (until > 0)
+    return;
+
+  inHook = true;
+  const size_t iv = interval.load(std::memory_order_relaxed);
+  until = next_interval(iv);
+  const auto weight = static_cast<int64_t>(std::max(size, iv));
+
+  void *frames[kDepth + kSkip];
+  const int n = backtrace(frames, kDepth + kSkip);
+  const uint32_t site = find_site(frames + kSkip, std::max(0, n - kSkip));
+  Site &s = sites[site];
+  s.allocBytes.fetch_add(weight, std::memory_order_relaxed);
+  s.allocCount.fetch_add(1, std::memory_order_relaxed);
+
+  const size_t w = window_of(p);
+  bool stored = false;
+  for (size_t i = 0; i < 8 && !stored; ++i) {
+    uintptr_t expected = 0;
+    if (sampleKeys[w + i].compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(p))) {
+      sampleInfo[w + i] = {site, weight};
+      stored = true;
+    }
+  }
+  if (stored) {
+    s.liveBytes.fetch_add(weight, std::memory_order_relaxed);
+    s.liveCount.fetch_add(1, std::memory_order_relaxed);
+    liveSamples.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+  inHook = false;
+}
+
+// 把 p 的采样从表里摘下来（还没更新统计），没有被采样返回 false
+inline bool take_sample(void *p, SampleInfo &info) {
+  if (liveSamples.load(std::memory_order_relaxed) == 0)
+    return false;
+  const size_t w = window_of(p);
+  for (size_t i = 0; i < 8; ++i) {
+    if (sampleKeys[w + i].load(std::memory_order_relaxed) == reinterpret_cast<uintptr_t>(p)) {
+      info = sampleInfo[w + i];
+      sampleKeys[w + i].store(0, std::memory_order_release);
+      return true;
+    }
+  }
+  return false;
+}
+
+// 摘下来的采样确实释放了：从调用点的存活统计里扣掉
+inline void drop_sample(const SampleInfo &info) {
+  sites[info.site].liveBytes.fetch_sub(info.weight, std::memory_order_relaxed);
+  sites[info.site].liveCount.fetch_sub(1, std::memory_order_relaxed);
+  liveSamples.fetch_sub(1, std::memory_order_relaxed);
+}
+
+// 摘下来的采样其实没有释放（realloc 失败）：放回表里；窗口已经被占满就只能丢掉
+inline void restore_sample(void *p, const SampleInfo &info) {
+  const size_t w = window_of(p);
+  for (size_t i = 0; i < 8; ++i) {
+    uintptr_t expected = 0;
+    if (sampleKeys[w + i].compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(p))) {
+      sampleInfo[w + i] = info;
+      return;
+    }
+  }
+  drop_sample(info);
+  dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void record_free(void *p) {
+  SampleInfo info;
+  if (take_sample(p, info))
+    drop_sample(info);
+}
+
+// 帧符号化：优先用动态符号表，找不到（可执行文件没加 -rdynamic）再用 addr2line
+inline std::string symbolize(void *addr, std::map<void *, std::string> &cache) {
+  auto it = cache.find(addr);
+  if (it != cache.end())
+    return it->second;
+  std::string out;
+  Dl_info info{};
+  void *pc = static_cast<char *>(addr) - 1; // 返回地址指向 call 的下一条指令
+  if (dladdr(pc, &info) != 0 && info.dli_sname != nullptr) {
+    int status = 0;
+    char *demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+    out = status == 0 ? demangled : info.dli_sname;
+    std::free(demangled);
+  } else if (info.dli_fname != nullptr) {
+    char cmd[512];
+    const auto offset = reinterpret_cast<uintptr_t>(pc) - reinterpret_cast<uintptr_t>(info.dli_fbase);
+    // 主程序的 dli_fname 可能是相对路径；/proc/self/exe 在 addr2line 子进程里又指向它自己，先解析出来
+    char exe[256] = {};
+    const char *file = info.dli_fname;
+    if (file[0] != '/' && readlink("/proc/self/exe", exe, sizeof(exe) - 1) > 0)
+      file = exe;
+    std::snprintf(cmd, sizeof(cmd), "addr2line -C -f -e '%s' 0x%lx 2>/dev/null", file,
+                  static_cast<unsigned long>(offset));
+    if (FILE *f = popen(cmd, "r")) {
+      char line[512];
+      if (std::fgets(line, sizeof(line), f) != nullptr && line[0] != '?') {
+        out = line;
+        out.erase(out.find_last_not_of('\n') + 1);
+      }
+      pclose(f);
+    }
+    if (out.empty()) {
+      std::snprintf(cmd, sizeof(cmd), "%s+0x%lx", info.dli_fname, static_cast<unsigned long>(offset));
+      out = cmd;
+    }
+  } else {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%p", addr);
+    out = buf;
+  }
+  return cache[addr] = out;
+}
+
+inline int signalPipe[2] = {-1, -1};
+
+inline void on_signal(int) {
+  const char c = 1;
+  [[maybe_unused]] ssize_t r = write(signalPipe[1], &c, 1); // 信号处理函数里只做异步信号安全的事
+}
+
+} // namespace detail
+
+inline void set_enabled(bool on) { detail::enabled.store(on); }
+inline void set_sample_interval(size_t bytes) { detail::interval.store(std::max<size_t>(bytes, 1)); }
+inline void set_top(size_t n) { detail::topN = n; }
+
+// 打印 top-N 存活（疑似泄漏）与 top-N 累计分配（抖动）
+inline void report(FILE *out = stderr, size_t topN = detail::topN) {
+  const bool saved = detail::inHook;
+  detail::inHook = true;
+  {
+    std::vector<const Site *> list;
+    for (const Site &s : detail::sites)
+      if (s.allocCount.load() > 0)
+        list.push_back(&s);
+    std::map<void *, std::string> symbols;
+
+    auto print = [&](const char *title, auto key) {
+      std::sort(list.begin(), list.end(), [&](const Site *a, const Site *b) { return key(a) > key(b); });
+      std::fprintf(out, "---- %s ----\n", title);
+      for (size_t i = 0; i < list.size() && i < topN; ++i) {
+        const Site *s = list[i];
+        if (key(s) <= 0)
+          break;
+        std::fprintf(out, "#%zu 存活 %.1f KB (%lld 个采样)  累计分配 %.1f KB (%lld 个采样)\n", i + 1,
+                     static_cast<double>(s->liveBytes.load()) / 1024, static_cast<long long>(s->liveCount.load()),
+                     static_cast<double>(s->allocBytes.load()) / 1024, static_cast<long long>(s->allocCount.load()));
+        if (s == &detail::sites[0])
+          std::fprintf(out, "    <调用点表已满，其余调用点>\n");
+        for (int f = 0; f < s->depth; ++f) {
+          const std::string name = detail::symbolize(s->frames[f], symbols);
+          std::fprintf(out, "    %s\n", name.c_str());
+          if (name == "main")
+            break;
+        }
+      }
+    };
+    std::fprintf(out, "==== 分配追踪报告（采样间隔 %zu 字节，估计值）====\n", detail::interval.load());
+    print("存活字节 top（疑似泄漏）", [](const Site *s) { return s->liveBytes.load(); });
+    print("累计分配 top（抖动）", [](const Site *s) { return s->allocBytes.load(); });
+    if (const uint64_t d = detail::dropped.load())
+      std::fprintf(out, "（采样表满丢弃 %llu 个采样）\n", static_cast<unsigned long long>(d));
+    std::fflush(out);
+  }
+  detail::inHook = saved;
+}
+
+// 收到信号 sig 时打印报告：处理函数只往管道写一个字节，由后台线程读出后打印
+inline void install_signal_handler(int sig = SIGUSR2) {
+  if (detail::signalPipe[0] >= 0 || pipe(detail::signalPipe) != 0)
+    return;
+  std::thread([] {
+    char c;
+    while (read(detail::signalPipe[0], &c, 1) == 1)
+      report();
+  }).detach();
+  struct sigaction sa {};
+  sa.sa_handler = detail::on_signal;
+  sa.sa_flags = SA_RESTART;
+  sigemptyset(&sa.sa_mask);
+  sigaction(sig, &sa, nullptr);
+}
+
+} // namespace alloctrack
+
+#ifdef ALLOC_TRACKER_HOOK
+// 替换 malloc 系列与全局 operator new/delete：只能在一个翻译单元里定义 ALLOC_TRACKER_HOOK
+
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t n, size_t size);
+void *__libc_realloc(void *p, size_t size);
+void *__libc_memalign(size_t align, size_t size);
+void __libc_free(void *p);
+
+__attribute__((noinline)) void *malloc(size_t size) noexcept {
+  void *p = __libc_malloc(size);
+  if (p != nullptr)
+    alloctrack::detail::record_alloc(p, size);
+  return p;
+}
+
+__attribute__((noinline)) void *calloc(size_t n, size_t size) noexcept {
+  void *p = __libc_calloc(n, size);
+  if (p != nullptr)
+    alloctrack::detail::record_alloc(p, n * size);
+  return p;
+}
+
+// 旧块的采样要在 __libc_realloc 之前摘下：旧块一旦释放，别的线程 malloc 可能拿到同一个地址并先登记采样，
+// 之后再按地址注销就可能删掉人家的采样。失败时（返回空指针且 size != 0）旧块仍然有效，把采样放回去；
+// size == 0 时 glibc 释放旧块并返回空指针
+__attribute__((noinline)) void *realloc(void *old, size_t size) noexcept {
+  alloctrack::detail::SampleInfo info{};
+  const bool sampled = old != nullptr && alloctrack::detail::take_sample(old, info);
+  void *p = __libc_realloc(old, size);
+  if (p == nullptr && size != 0) {
+    if (sampled)
+      alloctrack::detail::restore_sample(old, info);
+    return p;
+  }
+  if (sampled)
+    alloctrack::detail::drop_sample(info);
+  if (p != nullptr)
+    alloctrack::detail::record_alloc(p, size);
+  return p;
+}
+
+__attribute__((noinline)) void *memalign(size_t align, size_t size) noexcept {
+  void *p = __libc_memalign(align, size);
+  if (p != nullptr)
+    alloctrack::detail::record_alloc(p, size);
+  return p;
+}
+
+__attribute__((noinline)) void *aligned_alloc(size_t align, size_t size) noexcept {
+  void *p = __libc_memalign(align, size);
+  if (p != nullptr)
+    alloctrack::detail::record_alloc(p, size);
+  return p;
+}
+
+__attribute__((noinline)) int posix_memalign(void **out, size_t align, size_t size) noexcept {
+  if (align % sizeof(void *) != 0 || (align & (align - 1)) != 0)
+    return EINVAL;
+  void *p = __libc_memalign(align, size);
+  if (p == nullptr)
+    return ENOMEM;
+  alloctrack::detail::record_alloc(p, size);
+  *out = p;
+  return 0;
+}
+
+void free(void *p) noexcept {
+  if (p != nullptr)
+    alloctrack::detail::record_free(p);
+  __libc_free(p);
+}
+}
+
+// operator new 转发给上面的 malloc，调用栈里会多一帧 operator new
+void *operator new(size_t size) {
+  if (void *p = malloc(size == 0 ? 1 : size))
+    return p;
+  throw std::bad_alloc();
+}
+
+void *operator new[](size_t size) { return ::operator new(size); }
+void *operator new(size_t size, const std::nothrow_t &) noexcept { return malloc(size == 0 ? 1 : size); }
+void *operator new[](size_t size, const std::nothrow_t &) noexcept { return malloc(size == 0 ? 1 : size); }
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+// 对齐版本（alignas 超过 16 的类型）转发给 memalign
+void *operator new(size_t size, std::align_val_t align) {
+  if (void *p = memalign(static_cast<size_t>(align), size == 0 ? 1 : size))
+    return p;
+  throw std::bad_alloc();
+}
+
+void *operator new[](size_t size, std::align_val_t align) { return ::operator new(size, align); }
+void *operator new(size_t size, std::align_val_t align, const std::nothrow_t &) noexcept {
+  return memalign(static_cast<size_t>(align), size == 0 ? 1 : size);
+}
+void *operator new[](size_t size, std::align_val_t align, const std::nothrow_t &) noexcept {
+  return memalign(static_cast<size_t>(align), size == 0 ? 1 : size);
+}
+void operator delete(void *p, std::align_val_t) noexcept { free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { free(p); }
+void operator delete(void *p, size_t, std::align_val_t) noexcept { free(p); }
+void operator delete[](void *p, size_t, std::align_val_t) noexcept { free(p); }
+
+// 启动时读取环境变量、预热 backtrace（第一次调用会加载 libgcc 并分配内存）、登记退出时的报告
+__attribute__((constructor)) static void alloctrack_init() {
+  alloctrack::detail::inHook = true;
+  if (const char *v = std::getenv("ALLOC_TRACKER_SAMPLE"))
+    alloctrack::set_sample_interval(std::strtoull(v, nullptr, 10));
+  if (const char *v = std::getenv("ALLOC_TRACKER_TOP"))
+    alloctrack::set_top(std::strtoull(v, nullptr, 10));
+  const char *off = std::getenv("ALLOC_TRACKER");
+  const bool on = off == nullptr || std::strcmp(off, "0") != 0;
+  alloctrack::set_enabled(on);
+  void *frames[4];
+  backtrace(frames, 4);
+  if (on)
+    std::atexit([] { alloctrack::report(); });
+  alloctrack::detail::inHook = false;
+}
+#endif
@@ -0,0 +1,77 @@
+#define ALLOC_TRACKER_HOOK
+#include "alloc_tracker.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <signal.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+分配追踪演示
+  一、两个泄漏：m_sizeof.cpp 那样 malloc(100) 不 free；一个只进不出的 new std::string 缓存
+  二、一个高抖动的热点：反复构造/销毁字符串和 vector
+  三、运行中 raise(SIGUSR2) 打印一次报告；进程退出时再自动打印一次
+  四、开销：同样的抖动负载，分别在关闭追踪 / 默认采样 / 每次分配都采样 下计时
+*/
+
+void leak_like_sizeof(int n) {
+  for (int i = 0; i < n; ++i) {
+    void *vp = malloc(100); // 从不释放
+    static_cast<char *>(vp)[0] = 0;
+  }
+}
+
+std::vector<std::string *> &leaky_cache() {
+  static auto *cache = new std::vector<std::string *>();
+  return *cache;
+}
+
+void remember(int i) {
+  leaky_cache().push_back(new std::string("cached value that nobody ever evicts #" + std::to_string(i)));
+}
+
+size_t churn(int rounds) {
+  size_t total = 0;
+  for (int r = 0; r < rounds; ++r) {
+    std::vector<std::string> parts;
+    for (int i = 0; i < 8; ++i)
+      parts.emplace_back("header-field-" + std::to_string(r) + "-" + std::to_string(i) + "-long-enough");
+    for (const auto &p : parts)
+      total += p.size();
+  }
+  return total;
+}
+
+double timed_churn() {
+  const auto start = std::chrono::steady_clock::now();
+  [[maybe_unused]] volatile size_t sink = churn(50000);
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+  alloctrack::install_signal_handler(SIGUSR2);
+
+  leak_like_sizeof(20000);
+  for (int i = 0; i < 20000; ++i)
+    remember(i);
+  churn(100000);
+
+  // 运行中触发一次报告（生产中是 kill -USR2 <pid>）
+  raise(SIGUSR2);
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+  // 开销
+  alloctrack::set_enabled(false);
+  const double off = timed_churn();
+  alloctrack::set_enabled(true);
+  const double sampled = timed_churn();
+  alloctrack::set_sample_interval(1);
+  const double every = timed_churn();
+  alloctrack::set_sample_interval(512 * 1024);
+  std::cout << "\n抖动负载耗时  关闭: " << off << " s  采样(512KB): " << sampled << " s  每次都采样: " << every
+            << " s" << std::endl;
+  return 0;
+}